@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_bench_LatencyRecorder_hpp_
+#define _coffee_bench_LatencyRecorder_hpp_
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace coffee {
+
+namespace bench {
+
+/**
+ * Collects latency samples and reports the percentiles of the distribution.
+ *
+ * Each worker thread must own its recorder, and the results are merged once the workers have finished.
+ */
+class LatencyRecorder {
+public:
+   typedef std::chrono::nanoseconds Duration;
+
+   void reserve(const size_t size) noexcept { m_samples.reserve(size); }
+   void add(const Duration& sample) noexcept { m_samples.push_back(sample); m_sorted = false; }
+   void merge(const LatencyRecorder& other) noexcept {
+      m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());
+      m_sorted = false;
+   }
+
+   size_t size() const noexcept { return m_samples.size(); }
+   bool empty() const noexcept { return m_samples.empty(); }
+
+   /**
+    * \param rate Value in the range [0, 1].
+    * \return The sample under which the given rate of the samples are placed.
+    * \warning It sorts the samples, so it must not be called while other thread is adding samples.
+    */
+   Duration percentile(const double rate) noexcept {
+      if (m_samples.empty())
+         return Duration::zero();
+
+      if (!m_sorted) {
+         std::sort(m_samples.begin(), m_samples.end());
+         m_sorted = true;
+      }
+
+      size_t index = static_cast<size_t>(rate * (m_samples.size() - 1) + 0.5);
+      return m_samples[std::min(index, m_samples.size() - 1)];
+   }
+
+   void print(std::ostream& os, const char* name) noexcept {
+      typedef std::chrono::duration<double, std::micro> Microseconds;
+
+      os << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(2)
+         << " | samples=" << m_samples.size()
+         << " | p50=" << Microseconds(percentile(0.50)).count() << "us"
+         << " | p99=" << Microseconds(percentile(0.99)).count() << "us"
+         << " | p999=" << Microseconds(percentile(0.999)).count() << "us"
+         << " | max=" << Microseconds(percentile(1.0)).count() << "us"
+         << std::endl;
+   }
+
+private:
+   std::vector<Duration> m_samples;
+   bool m_sorted = false;
+};
+
+}
+}
+
+#endif // _coffee_bench_LatencyRecorder_hpp_
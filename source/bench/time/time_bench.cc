@@ -0,0 +1,421 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <coffee/app/ApplicationServiceStarter.hpp>
+#include <coffee/basis/pattern/observer/Observer.hpp>
+#include <coffee/time/Histogram.hpp>
+#include <coffee/time/TimeService.hpp>
+#include <coffee/time/Timer.hpp>
+
+#include <LatencyRecorder.hpp>
+
+using namespace coffee;
+
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+namespace {
+
+struct Arguments {
+   Arguments() : maxTime(60000), resolution(10), shards(1), minTimers(1000), maxTimers(1000000), expirations(20000), soak(0), threads(4) {;}
+
+   int maxTime;
+   int resolution;
+   int shards;
+   int minTimers;
+   int maxTimers;
+   int expirations;
+   int soak;
+   int threads;
+};
+
+class CounterObserver : public basis::pattern::observer::Observer {
+public:
+   CounterObserver() : basis::pattern::observer::Observer("CounterObserver"), m_counter(0) {;}
+
+   int64_t getCounter() const noexcept { return m_counter.load(); }
+
+private:
+   std::atomic<int64_t> m_counter;
+
+   void attached(const basis::pattern::observer::Subject& subject) noexcept {;}
+   void update(const basis::pattern::observer::Subject& subject, const basis::pattern::observer::Event& event) noexcept { ++ m_counter; }
+};
+
+// TimeService running on its own application, so every scenario starts with empty wheels and histograms
+class Scenario {
+public:
+   explicit Scenario(const Arguments& arguments) :
+      app("bench_coffee_time"),
+      observer(std::make_shared<CounterObserver>())
+   {
+      timeService = time::TimeService::instantiate(app, milliseconds(arguments.maxTime), milliseconds(arguments.resolution), arguments.shards);
+      timeService->attach(observer);
+      service = std::thread([this]() { app.start(); });
+      app.waitUntilRunning();
+      timeService->waitEffectiveRunning();
+   }
+
+   void stop() throw(basis::RuntimeException) {
+      app.stop();
+      service.join();
+   }
+
+   app::ApplicationServiceStarter app;
+   std::shared_ptr<time::TimeService> timeService;
+   std::shared_ptr<CounterObserver> observer;
+   std::thread service;
+};
+
+void usage(const char* program)
+{
+   std::cerr << "Usage: " << program << " [options]" << std::endl
+      << "   --max-time <ms>      Max time of the TimeService (default 60000)" << std::endl
+      << "   --resolution <ms>    Resolution of the TimeService (default 10)" << std::endl
+      << "   --shards <n>         Shards of the TimeService (default 1)" << std::endl
+      << "   --min-timers <n>     Live timers on the first round, it is multiplied by 10 on every round (default 1000)" << std::endl
+      << "   --max-timers <n>     Live timers on the last round (default 1000000)" << std::endl
+      << "   --expirations <n>    Timers used to measure the lateness of the expirations (default 20000)" << std::endl
+      << "   --soak <seconds>     Activates and cancels timers during the given time and checks that none is lost" << std::endl
+      << "   --threads <n>        Threads used by the soak test (default 4)" << std::endl;
+}
+
+bool parse(int argc, char** argv, Arguments& arguments)
+{
+   for (int ii = 1; ii < argc; ++ ii) {
+      const char* option = argv[ii];
+
+      if (ii + 1 == argc)
+         return false;
+
+      const int value = atoi(argv[++ ii]);
+
+      if (value <= 0)
+         return false;
+
+      if (strcmp(option, "--max-time") == 0)
+         arguments.maxTime = value;
+      else if (strcmp(option, "--resolution") == 0)
+         arguments.resolution = value;
+      else if (strcmp(option, "--shards") == 0)
+         arguments.shards = value;
+      else if (strcmp(option, "--min-timers") == 0)
+         arguments.minTimers = value;
+      else if (strcmp(option, "--max-timers") == 0)
+         arguments.maxTimers = value;
+      else if (strcmp(option, "--expirations") == 0)
+         arguments.expirations = value;
+      else if (strcmp(option, "--soak") == 0)
+         arguments.soak = value;
+      else if (strcmp(option, "--threads") == 0)
+         arguments.threads = value;
+      else
+         return false;
+   }
+
+   return arguments.resolution < arguments.maxTime && arguments.minTimers <= arguments.maxTimers;
+}
+
+size_t residentBytes()
+{
+   std::ifstream statm("/proc/self/statm");
+   size_t size = 0, resident = 0;
+   statm >> size >> resident;
+   return resident * sysconf(_SC_PAGESIZE);
+}
+
+void report(const char* name, const nanoseconds& elapsed, const int operations)
+{
+   const double seconds = std::chrono::duration<double>(elapsed).count();
+
+   std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(2)
+      << " | " << (double(elapsed.count()) / operations) << " ns/op"
+      << " | " << (operations / seconds) << " op/s"
+      << std::endl;
+}
+
+void report(const time::Histogram& histogram)
+{
+   std::cout << std::left << std::setw(32) << histogram.getName() << std::right
+      << " | samples=" << histogram.getCounter()
+      << " | avg=" << histogram.getAverage().count() << "us"
+      << " | p50<=" << histogram.getPercentile(50).count() << "us"
+      << " | p99<=" << histogram.getPercentile(99).count() << "us"
+      << " | p999<=" << histogram.getPercentile(99.9).count() << "us"
+      << " | max=" << histogram.getMax().count() << "us"
+      << std::endl;
+}
+
+// Activates the timers, measures the cost of the operations with all of them waiting and cancels them again
+void benchmarkLiveTimers(const Arguments& arguments, const int liveTimers)
+   throw(basis::RuntimeException)
+{
+   Scenario scenario(arguments);
+   time::TimeService& timeService = *scenario.timeService;
+
+   // Long timeouts, so no timer expires while it is being measured
+   std::mt19937 random(liveTimers);
+   std::uniform_int_distribution<int> timeouts(arguments.maxTime / 2, arguments.maxTime);
+
+   const size_t initialMemory = residentBytes();
+
+   std::vector<std::shared_ptr<time::Timer> > timers;
+   timers.reserve(liveTimers);
+
+   for (int ii = 0; ii < liveTimers; ++ ii) {
+      timers.push_back(time::Timer::instantiate(ii, milliseconds(timeouts(random))));
+   }
+
+   auto start = steady_clock::now();
+   for (auto& timer : timers) {
+      timeService.activate(timer);
+   }
+   auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start);
+
+   const size_t memory = residentBytes() - initialMemory;
+   const size_t wheelMemory = (time::TimeService::FirstLevelSize + (timeService.getLevels() - 1) * time::TimeService::LevelSize) * sizeof(void*) * timeService.getShards();
+
+   std::cout << std::endl << "LiveTimers=" << liveTimers
+      << " | MaxTime=" << arguments.maxTime << "ms"
+      << " | Resolution=" << arguments.resolution << "ms"
+      << " | Shards=" << timeService.getShards()
+      << " | Levels=" << timeService.getLevels()
+      << " | WheelMemory=" << wheelMemory << " bytes"
+      << " | MemoryPerTimer=" << (memory / liveTimers) << " bytes"
+      << std::endl;
+
+   report("TimeService::activate", elapsed, liveTimers);
+
+   // Every operation is timed, so the tail shows the waits for the lock held by the consumer
+   const int iterations = std::min(liveTimers, 200000);
+   bench::LatencyRecorder cancelLatencies;
+   bench::LatencyRecorder activateLatencies;
+   cancelLatencies.reserve(iterations);
+   activateLatencies.reserve(iterations);
+
+   for (int ii = 0; ii < iterations; ++ ii) {
+      auto& timer = timers[ii];
+
+      auto begin = steady_clock::now();
+      timeService.cancel(timer);
+      auto middle = steady_clock::now();
+      timeService.activate(timer);
+      auto end = steady_clock::now();
+
+      cancelLatencies.add(duration_cast<nanoseconds>(middle - begin));
+      activateLatencies.add(duration_cast<nanoseconds>(end - middle));
+   }
+
+   cancelLatencies.print(std::cout, "TimeService::cancel (live)");
+   activateLatencies.print(std::cout, "TimeService::activate (live)");
+
+   start = steady_clock::now();
+   for (auto& timer : timers) {
+      timeService.cancel(timer);
+   }
+   elapsed = duration_cast<nanoseconds>(steady_clock::now() - start);
+
+   report("TimeService::cancel", elapsed, liveTimers);
+
+   scenario.stop();
+}
+
+bool waitCounter(const CounterObserver& observer, const int64_t expected, const milliseconds& timeout)
+{
+   const auto limit = steady_clock::now() + timeout;
+
+   while (observer.getCounter() < expected) {
+      if (steady_clock::now() > limit)
+         return false;
+      std::this_thread::sleep_for(milliseconds(10));
+   }
+
+   return true;
+}
+
+// Lets the timers expire to measure how late they are notified
+bool benchmarkExpirations(const Arguments& arguments)
+   throw(basis::RuntimeException)
+{
+   Scenario scenario(arguments);
+   time::TimeService& timeService = *scenario.timeService;
+
+   const int longestTimeout = std::min(arguments.maxTime, 2000);
+   std::mt19937 random(arguments.expirations);
+   std::uniform_int_distribution<int> timeouts(arguments.resolution, longestTimeout);
+
+   for (int ii = 0; ii < arguments.expirations; ++ ii) {
+      timeService.activate(time::Timer::instantiate(ii, milliseconds(timeouts(random))));
+   }
+
+   const bool completed = waitCounter(*scenario.observer, arguments.expirations, milliseconds(longestTimeout * 2 + 1000));
+
+   std::cout << std::endl << "Expirations=" << arguments.expirations
+      << " | Notified=" << scenario.observer->getCounter()
+      << " | LongestTimeout=" << longestTimeout << "ms"
+      << std::endl;
+
+   report(timeService.getLateness());
+   report(timeService.getQuantumProcessing());
+   report(timeService.getCallbacks());
+
+   scenario.stop();
+
+   return completed;
+}
+
+struct SoakContext {
+   SoakContext() : activated(0), cancelled(0) {;}
+
+   int64_t activated;
+   int64_t cancelled;
+};
+
+void runSoak(time::TimeService& timeService, SoakContext& context, const int seed, const int longestTimeout, const steady_clock::time_point& limit)
+{
+   // Every slot keeps one timer, it is cancelled when it is still waiting and the slot is reused
+   static const int Slots = 10000;
+
+   std::vector<std::shared_ptr<time::Timer> > slots(Slots);
+   std::mt19937 random(seed);
+   std::uniform_int_distribution<int> timeouts(1, longestTimeout);
+
+   for (int64_t ii = 0; steady_clock::now() < limit; ++ ii) {
+      auto& slot = slots[ii % Slots];
+
+      if (slot && timeService.cancel(slot))
+         ++ context.cancelled;
+
+      slot = time::Timer::instantiate(ii, milliseconds(timeouts(random)));
+
+      try {
+         timeService.activate(slot);
+         ++ context.activated;
+      }
+      catch (basis::RuntimeException&) {
+         slot.reset();
+      }
+   }
+}
+
+// Every activated timer must be cancelled or expired, whatever the interleaving of the threads
+bool soak(const Arguments& arguments)
+   throw(basis::RuntimeException)
+{
+   Scenario scenario(arguments);
+   time::TimeService& timeService = *scenario.timeService;
+
+   const int longestTimeout = std::min(arguments.maxTime, 1000);
+   const size_t initialMemory = residentBytes();
+
+   std::vector<SoakContext> contexts(arguments.threads);
+   std::vector<std::thread> workers;
+
+   const auto limit = steady_clock::now() + std::chrono::seconds(arguments.soak);
+
+   for (int ii = 0; ii < arguments.threads; ++ ii) {
+      workers.push_back(std::thread(runSoak, std::ref(timeService), std::ref(contexts[ii]), ii, longestTimeout, std::cref(limit)));
+   }
+
+   for (auto& worker : workers) {
+      worker.join();
+   }
+
+   int64_t activated = 0;
+   int64_t cancelled = 0;
+
+   for (auto& context : contexts) {
+      activated += context.activated;
+      cancelled += context.cancelled;
+   }
+
+   const bool completed = waitCounter(*scenario.observer, activated - cancelled, milliseconds(longestTimeout * 2 + 1000));
+   const bool empty = timeService.empty();
+   const int64_t notified = scenario.observer->getCounter();
+
+   std::cout << std::endl << "Soak=" << arguments.soak << "s"
+      << " | Threads=" << arguments.threads
+      << " | Activated=" << activated
+      << " | Cancelled=" << cancelled
+      << " | Notified=" << notified
+      << " | Empty=" << std::boolalpha << empty
+      << " | MemoryGrowth=" << ((int64_t) residentBytes() - (int64_t) initialMemory) << " bytes"
+      << std::endl;
+
+   report(timeService.getLateness());
+   report(timeService.getQuantumProcessing());
+
+   scenario.stop();
+
+   return completed && empty && notified == activated - cancelled;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+   Arguments arguments;
+
+   if (!parse(argc, argv, arguments)) {
+      usage(argv[0]);
+      return 1;
+   }
+
+   try {
+      for (int64_t liveTimers = arguments.minTimers; liveTimers <= arguments.maxTimers; liveTimers *= 10) {
+         benchmarkLiveTimers(arguments, liveTimers);
+      }
+
+      if (!benchmarkExpirations(arguments)) {
+         std::cerr << "Some timer did not expire" << std::endl;
+         return 1;
+      }
+
+      if (arguments.soak > 0 && !soak(arguments)) {
+         std::cerr << "Soak test lost some timer" << std::endl;
+         return 1;
+      }
+   }
+   catch (basis::RuntimeException& ex) {
+      std::cerr << ex.asString() << std::endl;
+      return 1;
+   }
+
+   return 0;
+}
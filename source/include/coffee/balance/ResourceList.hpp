@@ -24,6 +24,7 @@
 #ifndef __coffee_balance_ResourceList_hpp
 #define __coffee_balance_ResourceList_hpp
 
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -44,6 +45,10 @@ class GuardResourceList;
 
 /**
  * List of resources with exclusive access.
+ *
+ * An immutable Snapshot of the list is published so the strategies could select a resource without
+ * locking the list. After the list changes the new Snapshot is published by #initialize or by the
+ * first #getSnapshot, so adding a bulk of resources only creates one of them.
  */
 class ResourceList : public basis::NamedObject  {
    typedef std::vector <std::shared_ptr<Resource> > resource_container;
@@ -52,11 +57,64 @@ public:
    typedef resource_container::iterator resource_iterator;
    typedef resource_container::const_iterator const_resource_iterator;
 
+   /**
+    * Immutable copy of the resources with a bitmap of their availability.
+    *
+    * The bitmap keeps the last known availability, it is refreshed periodically and when no resource seems available,
+    * the selected resource is always checked with Resource::isAvailable before returning it.
+    */
+   class Snapshot {
+   public:
+      /**
+       * Constructor.
+       * \param resources Resources to be copied.
+       */
+      explicit Snapshot(const resource_container& resources);
+
+      /**
+       * \return The number of resources.
+       */
+      size_t size() const noexcept { return m_resources.size(); }
+
+      /**
+       * \return the Resource at the position received as parameter.
+       * \warning index must be lesser than #size.
+       */
+      const std::shared_ptr<Resource>& at(const size_t index) const noexcept { return m_resources[index]; }
+
+      /**
+       * \return The position of the first available resource starting at \em from and continuing on the first one,
+       * or -1 if there is not any available resource.
+       */
+      int select(const size_t from) noexcept;
+
+      /**
+       * \return The number of resources which were available on the last check.
+       */
+      size_t countAvailable() const noexcept;
+
+      /**
+       * Check the availability of every resource.
+       */
+      void refresh() noexcept;
+
+   private:
+      typedef std::atomic<uint64_t> Word;
+      static const size_t WordBits = 64;
+
+      const resource_container m_resources;
+      const size_t m_wordCount;
+      std::unique_ptr<Word[]> m_words;
+      std::atomic<int64_t> m_refreshTime;
+
+      int findAvailable(const size_t from) const noexcept;
+   };
+
    /**
     * Constructor
     * \param name Logical name.
     */
-   explicit ResourceList(const char* name) : basis::NamedObject(name) {;}
+   explicit ResourceList(const char* name) : basis::NamedObject(name), m_snapshot(nullptr), m_outdated(true) {;}
 
    /**
     * Destructor.
@@ -110,6 +168,21 @@ public:
     */
    size_t countAvailableResources(GuardResourceList&) const noexcept;
 
+   /**
+    * \return The last snapshot of the resources. It does not require any lock.
+    */
+   Snapshot& getSnapshot() const noexcept {
+      if (m_outdated.load(std::memory_order_acquire))
+         publish();
+      return *m_snapshot.load(std::memory_order_acquire);
+   }
+
+   /**
+    * Check the availability of every resource, it should be called when some resource has recovered
+    * to use it without waiting for the periodical check.
+    */
+   void refreshAvailability() noexcept { getSnapshot().refresh(); }
+
    /**
     * \return resource_iterator to the first attached resource.
     */
@@ -147,11 +220,21 @@ public:
    virtual std::shared_ptr<xml::Node> asXML(std::shared_ptr<xml::Node>& parent) const throw(basis::RuntimeException);
 
 private:
+   typedef std::vector<std::unique_ptr<Snapshot> > snapshot_container;
+
    mutable std::mutex m_mutex;
    resource_container m_resources;
+   mutable std::atomic<Snapshot*> m_snapshot;
+   mutable std::atomic<bool> m_outdated;
+
+   // Published snapshots are kept until the destruction, a strategy could be still working on any of them
+   mutable snapshot_container m_snapshots;
 
    ResourceList(const ResourceList&);
 
+   void publish() const noexcept;
+   void publish(GuardResourceList&) const noexcept;
+
    friend class GuardResourceList;
 };
 
@@ -36,6 +36,8 @@ class GuardResourceList;
  * o resources. If the candidate resource would not be available then it will start a sequential search
  * for the first available resource.
  *
+ * The selection works on the ResourceList::Snapshot without locking the list.
+ *
  * \include test/balance/StrategyIndexed_test.cc
  */
 class StrategyIndexed : public Strategy {
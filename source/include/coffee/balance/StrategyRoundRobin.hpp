@@ -24,6 +24,8 @@
 #ifndef __coffee_balance_StrategyRoundRobin_hpp
 #define __coffee_balance_StrategyRoundRobin_hpp
 
+#include <atomic>
+
 #include "Strategy.hpp"
 #include "ResourceList.hpp"
 
@@ -36,6 +38,8 @@ class GuardResourceList;
  * Select a resource by using a Round Robin technique. If the candidate resource would not be available
  * then it will start a sequential search for the first available resource.
  *
+ * The selection works on the ResourceList::Snapshot without locking the list.
+ *
  * \include test/balance/StrategyRoundRobin_test.cc
  *
  */
@@ -45,7 +49,7 @@ public:
     * Constuctor.
     * \param resources List of resources to work with.
     */
-   explicit StrategyRoundRobin (std::shared_ptr<ResourceList>& resources) : Strategy("balance::RoundRobin", resources) {;}
+   explicit StrategyRoundRobin (std::shared_ptr<ResourceList>& resources) : Strategy("balance::RoundRobin", resources), m_position(0) {;}
 
    /**
     * Select a resource by using a Round Robin technique. If the candidate resource would not be available
@@ -57,23 +61,8 @@ public:
    std::shared_ptr<xml::Node> asXML(std::shared_ptr<xml::Node>& parent) const throw(basis::RuntimeException);
 
 private:
-   class Position {
-   public:
-      /**
-       * Constuctor.
-       * \param resources List of resources to work with.
-       */
-      Position() : valid(false) {;}
-
-      operator bool() { return valid; }
-      Position& operator=(ResourceList::resource_iterator other)  { iterator = other; valid = true; return *this; }
-      ResourceList::resource_iterator value() { return iterator; }
-
-   private:
-      bool valid;
-      ResourceList::resource_iterator iterator;
-   };
-   Position m_position;
+   // Position where the next selection will start
+   std::atomic<size_t> m_position;
 };
 
 } /* namespace balance */
@@ -94,6 +94,11 @@ protected:
     */
    void notify(const Event& event) noexcept;
 
+   /**
+    * Notify that event has occurred over this subject only to the received observer.
+    */
+   void notify(Observer& observer, const Event& event) noexcept;
+
    /**
     * \return service_iterator to the first attached observer.
     */
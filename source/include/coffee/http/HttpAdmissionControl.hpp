@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_http_HttpAdmissionControl_hpp_
+#define _coffee_http_HttpAdmissionControl_hpp_
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include <coffee/basis/RuntimeException.hpp>
+#include <coffee/basis/StreamString.hpp>
+
+namespace coffee {
+
+namespace xml {
+   class Node;
+}
+
+namespace http {
+
+/**
+ * Admission stage applied by the HttpService before calling the servlet registered for some path.
+ *
+ * It combines a token bucket, which limits the rate of accepted requests, with a limit on the number of
+ * requests being serviced at the same time. Requests which can not be admitted will be answered
+ * immediately with 503 (Service Unavailable) and a Retry-After header.
+ *
+ * \include test/http/HttpAdmissionControl_test.cc
+ */
+class HttpAdmissionControl {
+public:
+   /**
+    * Value to indicate that the request rate or the concurrency will not be limited.
+    */
+   static const int Unlimited = 0;
+
+   struct Result {
+      enum _v { Accepted, RateExceeded, ConcurrencyExceeded };
+      static const char* asString(const Result::_v value) noexcept;
+   };
+
+   /**
+    * Fast instantiation for this class
+    */
+   static std::shared_ptr<HttpAdmissionControl> instantiate(const int requestsPerSecond, const int burst, const int maxConcurrency)
+      throw(basis::RuntimeException)
+   {
+      return std::make_shared<HttpAdmissionControl>(requestsPerSecond, burst, maxConcurrency);
+   }
+
+   /**
+    * Constructor.
+    * \param requestsPerSecond Rate of refill of the token bucket. HttpAdmissionControl::Unlimited to disable the rate limit.
+    * \param burst Capacity of the token bucket, it would be the max number of requests accepted at once.
+    * \param maxConcurrency Max number of requests being serviced at the same time. HttpAdmissionControl::Unlimited to disable it.
+    */
+   HttpAdmissionControl(const int requestsPerSecond, const int burst, const int maxConcurrency) throw(basis::RuntimeException);
+
+   /**
+    * Tries to admit a new request. If the result is Result::Accepted the caller must call to #release
+    * once the request has been serviced.
+    */
+   Result::_v acquire() noexcept;
+
+   /**
+    * Notifies that one request previously admitted has been serviced.
+    */
+   void release() noexcept;
+
+   /**
+    * \return Seconds that the client should wait before retrying the request. It will be used as value of Retry-After header.
+    */
+   std::chrono::seconds getRetryAfter() const noexcept;
+
+   uint64_t getAcceptedCounter() const noexcept { std::lock_guard<std::mutex> guard(m_mutex); return m_acceptedCounter; }
+   uint64_t getRateExceededCounter() const noexcept { std::lock_guard<std::mutex> guard(m_mutex); return m_rateExceededCounter; }
+   uint64_t getConcurrencyExceededCounter() const noexcept { std::lock_guard<std::mutex> guard(m_mutex); return m_concurrencyExceededCounter; }
+   int getInFlight() const noexcept { std::lock_guard<std::mutex> guard(m_mutex); return m_inFlight; }
+
+   /**
+    * \return Summarize information of the instance
+    */
+   basis::StreamString asString() const noexcept;
+
+   /**
+    * \return Summarize information of this instance in a coffee::xml::Node.
+    */
+   std::shared_ptr<xml::Node> asXML(std::shared_ptr<xml::Node>& parent) const throw(basis::RuntimeException);
+
+private:
+   typedef std::chrono::steady_clock Clock;
+
+   const int m_requestsPerSecond;
+   const int m_burst;
+   const int m_maxConcurrency;
+   mutable std::mutex m_mutex;
+   double m_tokens;
+   Clock::time_point m_lastRefill;
+   int m_inFlight;
+   uint64_t m_acceptedCounter;
+   uint64_t m_rateExceededCounter;
+   uint64_t m_concurrencyExceededCounter;
+
+   HttpAdmissionControl(const HttpAdmissionControl&) = delete;
+
+   void refill(const Clock::time_point& now) noexcept;
+};
+
+}
+}
+
+#endif // _coffee_http_HttpAdmissionControl_hpp_
@@ -0,0 +1,69 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_http_HttpBodySource_hpp_
+#define _coffee_http_HttpBodySource_hpp_
+
+#include <stdint.h>
+
+#include <string>
+
+#include <coffee/basis/DataBlock.hpp>
+#include <coffee/basis/RuntimeException.hpp>
+
+namespace coffee {
+
+namespace http {
+
+/**
+ * Content which could be sent as body of a HTTP response without being loaded as a whole.
+ *
+ * \see HttpResponse::instantiate
+ */
+class HttpBodySource {
+public:
+   virtual ~HttpBodySource() {;}
+
+   /**
+    * @return the size of the complete content.
+    */
+   virtual uint64_t getSize() const noexcept = 0;
+
+   /**
+    * @return the entity tag used to evaluate the If-Range header. Empty string if the content can not be validated.
+    */
+   virtual std::string getEntityTag() const noexcept = 0;
+
+   /**
+    * Copies a segment of the content.
+    * \param offset First byte to copy.
+    * \param length Number of bytes to copy.
+    * \param target Buffer which will receive the segment.
+    */
+   virtual void copy(const uint64_t offset, const uint64_t length, basis::DataBlock& target) const throw(basis::RuntimeException) = 0;
+};
+
+}
+}
+
+#endif // _coffee_http_HttpBodySource_hpp_
@@ -0,0 +1,80 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_http_HttpByteRange_hpp_
+#define _coffee_http_HttpByteRange_hpp_
+
+#include <stdint.h>
+
+#include <string>
+
+namespace coffee {
+
+namespace http {
+
+/**
+ * Byte range requested by the header Range of a HTTP request.
+ *
+ * Only single ranges are supported. Requests with many ranges will be answered with the complete content,
+ * as RFC 7233 allows to do.
+ *
+ * \include test/http/HttpByteRange_test.cc
+ */
+class HttpByteRange {
+public:
+   struct Result {
+      enum _v { Ignored, Satisfiable, NotSatisfiable };
+      static const char* asString(const Result::_v value) noexcept;
+   };
+
+   HttpByteRange() : m_first(0), m_last(0) {;}
+
+   /**
+    * Interprets the value of a Range header for a resource of the given size.
+    * \param value The value of the Range header, for example: bytes=0-499, bytes=500- or bytes=-500.
+    * \param size Size of the complete resource.
+    * \param range It will receive the range to serve if the result is Result::Satisfiable.
+    * \return Result::Ignored when the value can not be understood, which means the complete content should be served.
+    */
+   static Result::_v parse(const std::string& value, const uint64_t size, HttpByteRange& range) noexcept;
+
+   uint64_t getFirst() const noexcept { return m_first; }
+   uint64_t getLast() const noexcept { return m_last; }
+   uint64_t getLength() const noexcept { return m_last - m_first + 1; }
+
+   /**
+    * @return the value for the Content-Range header, for example: bytes 0-499/1234.
+    */
+   std::string asContentRange(const uint64_t size) const noexcept;
+
+private:
+   uint64_t m_first;
+   uint64_t m_last;
+
+   static bool readNumber(const char*& ii, const char* end, uint64_t& value) noexcept;
+};
+
+}
+}
+
+#endif // _coffee_http_HttpByteRange_hpp_
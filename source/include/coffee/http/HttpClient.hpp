@@ -40,11 +40,19 @@ class HttpClient {
 public:
    std::shared_ptr<HttpResponse> send(const std::shared_ptr<HttpRequest>& request) throw(basis::RuntimeException);
 
+   /**
+    * Sends the request and fails once the deadline expires without any response.
+    * \see networking::ClientSocket::send
+    */
+   std::shared_ptr<HttpResponse> send(const std::shared_ptr<HttpRequest>& request, const std::shared_ptr<time::Deadline>& deadline) throw(basis::RuntimeException);
+
 private:
    std::shared_ptr<networking::ClientSocket> m_clientSocket;
    http::protocol::HttpProtocolEncoder m_encoder;
    http::protocol::HttpProtocolDecoder m_decoder;
 
+   std::shared_ptr<HttpResponse> decode(const basis::DataBlock& response) throw(basis::RuntimeException);
+
    explicit HttpClient(const std::shared_ptr<networking::ClientSocket>& clientSocket) : m_clientSocket(clientSocket) {}
 
    static std::shared_ptr<HttpClient> instantiate(const std::shared_ptr<networking::ClientSocket>& clientSocket) noexcept {
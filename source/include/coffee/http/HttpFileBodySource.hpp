@@ -0,0 +1,62 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_http_HttpFileBodySource_hpp_
+#define _coffee_http_HttpFileBodySource_hpp_
+
+#include <memory>
+
+#include <coffee/http/HttpBodySource.hpp>
+
+namespace coffee {
+
+namespace http {
+
+/**
+ * Serves the content of a file mapped on memory, so only the pages of the requested ranges will be read from disk.
+ */
+class HttpFileBodySource : public HttpBodySource {
+public:
+   static std::shared_ptr<HttpFileBodySource> instantiate(const std::string& path) throw(basis::RuntimeException);
+
+   ~HttpFileBodySource();
+
+   const std::string& getPath() const noexcept { return m_path; }
+
+   uint64_t getSize() const noexcept { return m_size; }
+   std::string getEntityTag() const noexcept { return m_entityTag; }
+   void copy(const uint64_t offset, const uint64_t length, basis::DataBlock& target) const throw(basis::RuntimeException);
+
+private:
+   const std::string m_path;
+   const char* m_data;
+   uint64_t m_size;
+   std::string m_entityTag;
+
+   explicit HttpFileBodySource(const std::string& path) : m_path(path), m_data(nullptr), m_size(0) {;}
+};
+
+}
+}
+
+#endif // _coffee_http_HttpFileBodySource_hpp_
@@ -67,18 +67,18 @@ public:
     * Sets the body of this Message.
     * @param body The new body of this message.
     */
-   HttpMessage& setBody(const basis::DataBlock& body) throw () { m_body = body; return *this; }
+   HttpMessage& setBody(const basis::DataBlock& body) throw () { m_body = body; ++ m_bodyVersion; return *this; }
 
    /**
  * Sets the body of this Message.
  * @param body The new body of this message.
  */
-   HttpMessage& setBody(const char* body) throw () { m_body = body; return *this; }
+   HttpMessage& setBody(const char* body) throw () { m_body = body; ++ m_bodyVersion; return *this; }
 
    /**
     * Clear the body of this Message.
     */
-   HttpMessage& clearBody() throw () { m_body.clear(); return *this; }
+   HttpMessage& clearBody() throw () { m_body.clear(); ++ m_bodyVersion; return *this; }
 
    /**
     * Resets all components of this message.
@@ -87,6 +87,8 @@ public:
       m_directory.clear();
       m_sequentialHeaders.clear();
       m_body.clear();
+      ++ m_bodyVersion;
+      ++ m_headersVersion;
    }
 
    uint16_t getMajorVersion() const noexcept { return m_majorVersion; }
@@ -99,7 +101,9 @@ protected:
     */
    HttpMessage(const uint16_t majorVersion, const uint16_t minorVersion) :
       m_majorVersion(majorVersion),
-      m_minorVersion(minorVersion)
+      m_minorVersion(minorVersion),
+      m_bodyVersion(0),
+      m_headersVersion(0)
    {}
 
    /**
@@ -112,6 +116,17 @@ protected:
     */
    virtual std::string encodeFirstLine() const throw(basis::RuntimeException) = 0;
 
+   /**
+    * @return a counter which changes every time the body is modified. It lets to detect that the information
+    * obtained from a previous body is not valid anymore.
+    */
+   uint32_t getBodyVersion() const noexcept { return m_bodyVersion; }
+
+   /**
+    * @return a counter which changes every time some header is modified.
+    */
+   uint32_t getHeadersVersion() const noexcept { return m_headersVersion; }
+
 private:
    const uint16_t m_majorVersion;
    const uint16_t m_minorVersion;
@@ -119,6 +134,8 @@ private:
    SequentialHeaders m_sequentialHeaders;
    std::unordered_map<std::string, SequentialHeaders::iterator> m_directory;
    basis::DataBlock m_body;
+   uint32_t m_bodyVersion;
+   uint32_t m_headersVersion;
 
    friend class protocol::HttpProtocolEncoder;
 };
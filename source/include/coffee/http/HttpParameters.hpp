@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_http_HttpParameters_hpp_
+#define _coffee_http_HttpParameters_hpp_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <coffee/basis/RuntimeException.hpp>
+
+namespace coffee {
+
+namespace http {
+
+/**
+ * Parameters encoded as application/x-www-form-urlencoded, as used by the query of an URL or by the body of an HTML form.
+ *
+ * The pairs are kept on a flat open-addressing table. Keys and values which do not need to be decoded reference
+ * the parsed buffer, so that buffer must not be modified nor released while this instance is in use.
+ * When the same key is repeated the first value will be the one recovered.
+ *
+ * \include test/http/HttpParameters_test.cc
+ */
+class HttpParameters {
+public:
+   HttpParameters() : m_data(nullptr), m_size(0) {;}
+
+   /**
+    * Replaces the current content with the pairs contained in the buffer.
+    * Malformed percent-encodings will be kept as they are.
+    */
+   void parse(const char* data, const size_t size) noexcept;
+
+   size_t size() const noexcept { return m_size; }
+   bool empty() const noexcept { return m_size == 0; }
+
+   bool hasParameter(const std::string& name) const noexcept { return lookup(name) != nullptr; }
+
+   /**
+    * @return the decoded value of the given parameter. It will throw an exception if the parameter is not found.
+    */
+   std::string getValue(const std::string& name) const throw(basis::RuntimeException);
+
+   /**
+    * @return the decoded value of the given parameter or the default value if it is not found.
+    */
+   std::string getValue(const std::string& name, const std::string& defaultValue) const noexcept;
+
+private:
+   struct Reference {
+      uint32_t offset;
+      uint32_t size;
+      bool decoded;
+   };
+
+   struct Slot {
+      Slot() : hash(0), used(false) {;}
+
+      uint32_t hash;
+      bool used;
+      Reference key;
+      Reference value;
+   };
+
+   const char* m_data;
+   std::string m_decoded;
+   std::vector<Slot> m_slots;
+   size_t m_size;
+
+   const Slot* lookup(const std::string& name) const noexcept;
+   Reference makeReference(const char* begin, const char* end) noexcept;
+   const char* address(const Reference& reference) const noexcept {
+      return (reference.decoded ? m_decoded.data(): m_data) + reference.offset;
+   }
+   std::string asString(const Reference& reference) const noexcept { return std::string(address(reference), reference.size); }
+
+   static uint32_t calculateHash(const char* data, const size_t size) noexcept;
+};
+
+}
+}
+
+#endif // _coffee_http_HttpParameters_hpp_
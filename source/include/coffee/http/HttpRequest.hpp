@@ -25,6 +25,7 @@
 #define _coffee_http_HttpRequest_hpp_
 
 #include <coffee/http/HttpMessage.hpp>
+#include <coffee/http/HttpParameters.hpp>
 #include <coffee/http/url/defines.hpp>
 #include <coffee/http/url/URL.hpp>
 
@@ -55,9 +56,32 @@ public:
       throw(basis::RuntimeException);
 
    const Method::_v getMethod() const noexcept { return m_method; }
-   std::shared_ptr<url::URL> getURL() const noexcept { m_url; }
+   std::shared_ptr<url::URL> getURL() const noexcept { return m_url; }
 
-   const std::string& getPath() const throw(basis::RuntimeException) { return m_url->getComponent(url::ComponentName::Path); }
+   std::string getPath() const throw(basis::RuntimeException) { return m_url->getComponent(url::ComponentName::Path); }
+
+   /**
+    * @return the parameters received on the query of the URL. They are parsed the first time this method is called.
+    */
+   const HttpParameters& getQueryParameters() const noexcept;
+
+   /**
+    * @return the parameters received on a body with Content-Type application/x-www-form-urlencoded. They are
+    * parsed the first time this method is called, and again only if the body is modified.
+    */
+   const HttpParameters& getFormParameters() const noexcept;
+
+   /**
+    * @return \b true if the parameter was received on the query or on the form body.
+    */
+   bool hasParameter(const std::string& name) const noexcept {
+      return getQueryParameters().hasParameter(name) || getFormParameters().hasParameter(name);
+   }
+
+   /**
+    * @return the value of the parameter, looking for it first on the query and then on the form body.
+    */
+   std::string getParameter(const std::string& name) const throw(basis::RuntimeException);
 
 protected:
    /**
@@ -66,7 +90,11 @@ protected:
    HttpRequest(const Method::_v method, const std::shared_ptr<url::URL>& url, const uint32_t majorVersion, const uint32_t minorVersion) :
       HttpMessage(majorVersion, minorVersion),
       m_method(method),
-      m_url(url)
+      m_url(url),
+      m_queryParsed(false),
+      m_formParsed(false),
+      m_formBodyVersion(0),
+      m_formHeadersVersion(0)
    {}
 
    /**
@@ -77,6 +105,12 @@ protected:
 private:
    const Method::_v m_method;
    std::shared_ptr<url::URL> m_url;
+   mutable HttpParameters m_queryParameters;
+   mutable bool m_queryParsed;
+   mutable HttpParameters m_formParameters;
+   mutable bool m_formParsed;
+   mutable uint32_t m_formBodyVersion;
+   mutable uint32_t m_formHeadersVersion;
 };
 
 }
@@ -35,6 +35,7 @@ class HttpProtocolWaitingMessage;
 }
 }
 class HttpRequest;
+class HttpBodySource;
 
 /**
  * General definition for HTTP requests following RFC 2616.
@@ -62,6 +63,15 @@ public:
       return result;
    }
 
+   /**
+    * Creates the response to serve the content of the given source, applying the Range and If-Range headers of the request.
+    *
+    * It will answer with 206 (Partial Content) and only the requested segment when the range is satisfiable, with
+    * 416 (Requested range not satisfiable) when it is out of the content, or with 200 and the complete content otherwise.
+    */
+   static std::shared_ptr<HttpResponse> instantiate(const std::shared_ptr<HttpRequest>& request, const HttpBodySource& source)
+      throw(basis::RuntimeException);
+
    HttpResponse& setStatusCode(const int statusCode) noexcept { m_statusCode = statusCode; return *this; }
    HttpResponse& setErrorDescription(const std::string& errorDescription) noexcept { m_errorDescription = errorDescription; return *this; }
 
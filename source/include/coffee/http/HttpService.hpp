@@ -43,13 +43,14 @@ namespace http {
 
 class HttpServlet;
 class HttpClient;
+class HttpAdmissionControl;
 
 class HttpService : public app::Service {
 public:
    static const int DefaultHttpPort = 80;
    static const std::string Implementation;
 
-   ~HttpService() { m_servlets.clear(); }
+   ~HttpService() { m_admissionControls.clear(); m_servlets.clear(); }
 
    static std::shared_ptr<HttpService> instantiate(app::Application& app, std::shared_ptr<networking::NetworkingService> networkingService) throw(basis::RuntimeException);
 
@@ -64,13 +65,28 @@ public:
 
    std::shared_ptr<HttpServlet> findServlet(const std::string& path) throw(basis::RuntimeException);
 
+   /**
+    * Attach the admission control to be applied to requests addressed to the received path. Requests
+    * which can not be admitted will be answered with 503 and Retry-After header without calling the servlet.
+    * \param path Path of a servlet already registered.
+    * \param admissionControl Admission control to apply.
+    */
+   void setAdmissionControl(const std::string& path, std::shared_ptr<HttpAdmissionControl> admissionControl) throw(basis::RuntimeException);
+
+   /**
+    * \return the admission control associated to the path or an empty pointer if the path has not got any.
+    */
+   std::shared_ptr<HttpAdmissionControl> findAdmissionControl(const std::string& path) const noexcept;
+
    std::shared_ptr<xml::Node> asXML(std::shared_ptr<xml::Node>& parent) const throw(basis::RuntimeException);
 
 private:
    typedef std::unordered_map<std::string, std::shared_ptr<HttpServlet> > Servlets;
+   typedef std::unordered_map<std::string, std::shared_ptr<HttpAdmissionControl> > AdmissionControls;
 
    std::shared_ptr<networking::NetworkingService> m_networkingService;
    Servlets m_servlets;
+   AdmissionControls m_admissionControls;
 
    HttpService(app::Application& app, std::shared_ptr<networking::NetworkingService> networkingService);
 
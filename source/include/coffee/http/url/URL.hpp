@@ -25,6 +25,8 @@
 #ifndef _coffee_http_url_URL_hpp_
 #define _coffee_http_url_URL_hpp_
 
+#include <mutex>
+
 #include <coffee/http/url/ComponentName.hpp>
 #include <coffee/http/url/defines.hpp>
 #include <coffee/basis/RuntimeException.hpp>
@@ -55,24 +57,63 @@ scheme              path
 class URL {
 public:
    bool hasComponent(const ComponentName::_v component) const noexcept {
-      return m_components.find(component) != m_components.end();
+      return m_segments[component].size != 0;
    }
 
-   const std::string& getComponent(const ComponentName::_v component) const throw(basis::RuntimeException);
+   /**
+    * @return a copy of the given component, the URL only keeps the offsets of every component into its own buffer.
+    */
+   std::string getComponent(const ComponentName::_v component) const throw(basis::RuntimeException);
 
-   bool hasQuery() const noexcept  { return !m_query.empty(); }
-   keyvalue_iterator query_begin() const noexcept { return m_query.begin(); }
-   keyvalue_iterator query_end() const noexcept { return m_query.end(); }
+   /**
+    * The query will be split and percent-decoded the first time it is iterated.
+    */
+   bool hasQuery() const noexcept  { return m_query.size != 0; }
+   keyvalue_iterator query_begin() const noexcept { return getKeyValues().begin(); }
+   keyvalue_iterator query_end() const noexcept { return getKeyValues().end(); }
    static const KeyValue& keyValue(const keyvalue_iterator ii) noexcept { return *ii; }
 
-   std::string encode() const throw(basis::RuntimeException);
+   /**
+    * @return the query without decoding, it will be valid meanwhile this URL exists.
+    */
+   std::pair<const char*, size_t> getEncodedQuery() const noexcept {
+      return std::make_pair(m_buffer.data() + m_query.offset, m_query.size);
+   }
+
+   const std::string& encode() const noexcept { return m_buffer; }
+
+   /**
+    * Decodes the percent-encoded characters and the '+' used as white space.
+    * \param data Buffer to decode, it must be verified by #isEncodingValid.
+    * \param size Number of bytes to decode.
+    * \param result Decoded text will be appended to this string.
+    */
+   static void decode(const char* data, const size_t size, std::string& result) noexcept;
+
+   /**
+    * @return \b true if every '%' on the buffer is followed by two hexadecimal digits.
+    */
+   static bool isEncodingValid(const char* data, const size_t size) noexcept;
 
 private:
-   const std::map<ComponentName::_v, std::string> m_components;
-   const Query m_query;
+   struct Segment {
+      Segment() : offset(0), size(0) {;}
+      Segment(const size_t _offset, const size_t _size) : offset(_offset), size(_size) {;}
+
+      size_t offset;
+      size_t size;
+   };
+   typedef Segment Segments[ComponentName::Fragment + 1];
+
+   const std::string m_buffer;
+   Segments m_segments;
+   const Segment m_query;
+   mutable Query m_keyValues;
+   mutable std::once_flag m_keyValuesDecoded;
+
+   URL(const std::string& buffer, const Segments& segments, const Segment& query);
 
-   explicit URL(const URLBuilder& builder);
-   explicit URL(const URLParser& parser);
+   const Query& getKeyValues() const noexcept;
 
    friend class URLBuilder;
    friend class URLParser;
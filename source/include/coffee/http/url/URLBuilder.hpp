@@ -28,13 +28,12 @@
 #include <coffee/http/url/defines.hpp>
 #include <coffee/basis/RuntimeException.hpp>
 #include <boost/shared_ptr.hpp>
+#include <coffee/http/url/URL.hpp>
 
 namespace coffee {
 namespace http {
 namespace url {
 
-class URL;
-
 /**
  * \see https://en.wikipedia.org/wiki/Uniform_Resource_Identifier#Syntax
  *
@@ -55,6 +54,10 @@ class URLBuilder {
 public:
    URLBuilder() {;}
    URLBuilder& setCompoment(const ComponentName::_v component, const std::string& value) throw(basis::RuntimeException);
+
+   /**
+    * The key and the value will be percent-encoded while the URL is built.
+    */
    URLBuilder& addKeyValue(const std::string& key, const std::string& value) noexcept {
       m_keyValues.push_back(KeyValue(key,value));
       return *this;
@@ -66,7 +69,8 @@ private:
    std::map<ComponentName::_v, std::string> m_components;
    Query m_keyValues;
 
-   friend class URL;
+   bool append(std::string& buffer, URL::Segments& segments, const ComponentName::_v component, const char* prefix, const char* suffix) const noexcept;
+   static void encode(const std::string& value, std::string& buffer) noexcept;
 };
 
 }
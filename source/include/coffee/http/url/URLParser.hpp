@@ -31,13 +31,12 @@
 #include <coffee/basis/RuntimeException.hpp>
 #include <boost/shared_ptr.hpp>
 #include <coffee/http/url/ComponentName.hpp>
+#include <coffee/http/url/URL.hpp>
 
 namespace coffee {
 namespace http {
 namespace url {
 
-class URL;
-
 /**
  * \see https://en.wikipedia.org/wiki/Uniform_Resource_Identifier#Syntax
  *
@@ -60,25 +59,23 @@ public:
    std::shared_ptr<URL> build() throw(basis::RuntimeException);
 
 private:
-   const std::string m_url;
-
-   typedef std::pair<std::string, std::string::size_type> Token;
+   typedef std::string::size_type size_type;
 
-   std::map<ComponentName::_v, std::string> m_components;
-   Query m_keyValues;
-
-   std::string::size_type readAuthority(const std::string& withoutScheme) throw(basis::RuntimeException);
-   std::string::size_type readPath(const std::string& withoutScheme, const std::string::size_type endPrevious) noexcept ;
-   std::string::size_type readQuery(const std::string& withoutScheme, const std::string::size_type endPrevious) throw(basis::RuntimeException) ;
-   void readFragment(const std::string& withoutScheme, const std::string::size_type endPrevious) noexcept;
+   const std::string m_url;
+   URL::Segments m_segments;
+   URL::Segment m_query;
 
-   void addMandatoryComponent(const ComponentName::_v componentName, const std::string& value) throw(basis::RuntimeException);
-   void addOptionalComponent(const ComponentName::_v componentName, const std::string& value) noexcept ;
-   static const std::string& verifyPortIsNumeric(const std::string& value) throw(basis::RuntimeException);
+   size_type readAuthority(const size_type begin) throw(basis::RuntimeException);
+   size_type readPath(const size_type begin) noexcept;
+   size_type readQuery(const size_type begin) throw(basis::RuntimeException);
+   void readFragment(const size_type begin) noexcept;
 
-   static Token extractToken(const std::string& withoutScheme, const std::string::size_type initpos, const char* finalDelims) noexcept;
+   void addMandatoryComponent(const ComponentName::_v componentName, const size_type begin, const size_type end) throw(basis::RuntimeException);
+   void addOptionalComponent(const ComponentName::_v componentName, const size_type begin, const size_type end) noexcept;
+   void verifyPortIsNumeric() const throw(basis::RuntimeException);
 
-   friend class URL;
+   size_type find(const char delim, const size_type begin, const size_type end) const noexcept;
+   size_type findFirstOf(const char* delims, const size_type begin) const noexcept;
 };
 
 }
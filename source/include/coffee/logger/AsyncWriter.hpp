@@ -0,0 +1,144 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef __coffee_logger_AsyncWriter_hpp
+#define __coffee_logger_AsyncWriter_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <coffee/logger/Writer.hpp>
+
+namespace coffee {
+
+namespace logger {
+
+/**
+ * Decorates other writer to move the writing out of the threads which generate the traces.
+ *
+ * The lines are stored into a bounded lock-free ring which accepts many producers, and a dedicated thread
+ * drains them in batches through Writer::applyBatch, so writers based on files will use only one system call
+ * for every batch.
+ *
+ * The binary traces generated through LOG_RECORD are stored without formatting and the message is built by
+ * the dedicated thread.
+ *
+ * \code
+ * auto writer = std::make_shared<logger::AsyncWriter>(std::make_shared<logger::UnlimitedTraceWriter>("trace.log"), 8192);
+ * logger::Logger::initialize(writer);
+ * \endcode
+ *
+ * \include test/logger/AsyncWriter_test.cc
+ */
+class AsyncWriter : public Writer {
+public:
+   /**
+    * What to do when the ring is full.
+    */
+   struct OverflowPolicy {
+      enum _v {
+         Block, ///< The thread which generates the trace will wait till there is room for the new line.
+         Drop ///< The new line will be discarded and counted.
+      };
+      static const char* asString(const OverflowPolicy::_v value) noexcept;
+   };
+
+   static const int MinimalCapacity = 64;
+   static const int MaxBatchSize = 512;
+
+   /**
+    * Constructor.
+    * \param target Writer which will receive the lines from the background thread.
+    * \param capacity Number of lines that the ring could hold. It will be rounded up to a power of two.
+    * \param overflowPolicy Policy applied when the ring is full.
+    */
+   AsyncWriter(std::shared_ptr<Writer> target, const size_t capacity, const OverflowPolicy::_v overflowPolicy = OverflowPolicy::Drop);
+
+   /**
+    * Destructor. The lines still stored on the ring will be written before returning.
+    */
+   ~AsyncWriter();
+
+   static std::shared_ptr<AsyncWriter> instantiate(std::shared_ptr<Writer> target, const size_t capacity, const OverflowPolicy::_v overflowPolicy = OverflowPolicy::Drop) {
+      return std::make_shared<AsyncWriter>(target, capacity, overflowPolicy);
+   }
+
+   size_t getCapacity() const noexcept { return m_slots.size(); }
+   OverflowPolicy::_v getOverflowPolicy() const noexcept { return m_overflowPolicy; }
+   unsigned int getDroppedCounter() const noexcept { return m_droppedCounter.load(std::memory_order_relaxed); }
+   unsigned int getWrittenCounter() const noexcept { return m_writtenCounter.load(std::memory_order_relaxed); }
+
+   /**
+    * Waits till every line accepted before calling this method has been delivered to the target writer.
+    */
+   void flush() noexcept;
+
+protected:
+   bool wantsToProcess(const Level::_v level) const noexcept { return m_target->wantsToProcess(level); }
+
+private:
+   struct Slot {
+      std::atomic<size_t> sequence;
+      Line line;
+      bool record;
+   };
+
+   const std::shared_ptr<Writer> m_target;
+   const OverflowPolicy::_v m_overflowPolicy;
+   std::vector<Slot> m_slots;
+   const size_t m_mask;
+   std::atomic<size_t> m_enqueuePosition;
+   std::atomic<size_t> m_dequeuePosition;
+   std::atomic<unsigned int> m_droppedCounter;
+   std::atomic<unsigned int> m_writtenCounter;
+
+   std::thread m_consumer;
+   std::atomic<bool> m_stop;
+   std::atomic<bool> m_sleeping;
+   std::atomic<int> m_blockedProducers;
+   std::mutex m_mutex;
+   std::condition_variable m_notEmpty;
+   std::condition_variable m_notFull;
+
+   void initialize() throw(basis::RuntimeException);
+   void apply(const Level::_v level, const std::string& line) noexcept;
+   bool applyRecord(const Level::_v level, const Record& record) noexcept;
+
+   void push(const Level::_v level, const std::string& data, const bool record) noexcept;
+   bool tryPush(const Level::_v level, const std::string& data, const bool record) noexcept;
+   size_t pop(std::vector<Line>& batch) noexcept;
+   void wakeUpConsumer() noexcept;
+   void stop() noexcept;
+   void run() noexcept;
+
+   static size_t calculateCapacity(const size_t capacity) noexcept;
+};
+
+}
+}
+
+#endif
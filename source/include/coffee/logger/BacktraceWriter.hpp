@@ -24,7 +24,9 @@
 #ifndef __coffee_logger_BacktraceWriter_hpp
 #define __coffee_logger_BacktraceWriter_hpp
 
-#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include <coffee/logger/CircularTraceWriter.hpp>
 
@@ -38,6 +40,10 @@ namespace logger {
  * trace of error is detected. This way when you get and error you should get
  * the 1024 previous lines of debugging or information previous to that error.
  *
+ * Every thread stores its lines on its own ring of preallocated slots which are overwritten in place, so
+ * collecting a line does not allocate memory nor compete with other threads. When an error is detected
+ * the rings are merged by timestamp and the newest lines are written.
+ *
  * \include test/logger/BacktraceWriter_test.cc
  */
 class BacktraceWriter : public CircularTraceWriter {
@@ -55,20 +61,28 @@ public:
    /**
     * Set the lowest level of traces to be collected. By default the lowest level would be coffee::logger::Level::Debug.
     */
-   void setLowestLeveL (const Level::_v lowestLeveL) noexcept { if (lowestLeveL > Level::Error) m_lowestLevel = lowestLeveL; }
+   void setLowestLeveL (const Level::_v lowestLeveL) noexcept {
+      if (lowestLeveL > Level::Error) {
+         m_lowestLevel = lowestLeveL;
+         levelsChanged();
+      }
+   }
 
 private:
-   typedef std::pair <Level::_v, std::string> Line;
-   typedef std::list <Line> Lines;
+   struct History;
+   struct ThreadHistory;
+   typedef std::vector<std::shared_ptr<History> > Histories;
 
    const int m_backtrackingLength;
-   Lines m_lines;
-   int m_lineCounter;
+   const unsigned m_id;
    Level::_v m_lowestLevel;
+   std::mutex m_mutex;
+   Histories m_histories;
 
    void apply (const Level::_v level, const std::string& line) noexcept;
    bool wantsToProcess (const Level::_v level) const noexcept { return level <= m_lowestLevel; }
    void backtrace () noexcept;
+   History& getHistory() noexcept;
 };
 
 } /* namespace logger */
@@ -41,6 +41,7 @@ public:
    static const int MinimalKbSize = 256;
    static const int NullStream ;
    static const int CheckSizePeriod = 128; ///< The size will be check every CheckSizePeriod Lines
+   static const int MaxBatchLines = 512; ///< Max number of lines written between two checks of the size
 
    /**
     * Constructor.
@@ -62,6 +63,7 @@ public:
 protected:
    virtual void apply (const Level::_v level, const std::string& line) noexcept;
    virtual bool wantsToProcess (const Level::_v level) const noexcept;
+   virtual void applyBatch(const Line* lines, const size_t size) noexcept;
 
 private:
    std::string m_path;
@@ -73,9 +75,12 @@ private:
    void initialize () throw (basis::RuntimeException);
 
    void openStream () throw (basis::RuntimeException);
+   int createStream () throw (basis::RuntimeException);
    bool oversizedStream () throw (basis::RuntimeException);
    void closeStream () noexcept;
    void renameFile () throw (basis::RuntimeException);
+   void rotate() throw (basis::RuntimeException);
+   void rotateIfOversized() noexcept;
 };
 
 }
@@ -41,23 +41,45 @@ namespace logger {
 [23/02/2018 10:38:33] Notice | void DefaultFormatter_test::test_method() [coffee/test/logger/DefaultFormatter_test.cc(61)]:  numeric value=5
 [23/02/2018 10:38:33] Information | void DefaultFormatter_test::test_method() [coffee/test/logger/DefaultFormatter_test.cc(61)]:  numeric value=6
 \endcode
+ *
+ * The date is rendered only once per second and thread, the fraction of second required by the Precision
+ * is appended with integer formatting. With Precision::Seconds the timestamp is taken from the time::CoarseClock.
  */
 class DefaultFormatter : public Formatter {
 public:
+   /**
+    * Resolution of the timestamp written on every line.
+    */
+   struct Precision {
+      enum _v {
+         Seconds, ///< [23/02/2018 10:38:33]
+         Milliseconds, ///< [23/02/2018 10:38:33.123]
+         Microseconds ///< [23/02/2018 10:38:33.123456]
+      };
+      static const char* asString(const Precision::_v value) noexcept;
+   };
+
    /**
     * Constructor.
+    * \param precision Resolution of the timestamp.
     */
-   DefaultFormatter() {;}
+   explicit DefaultFormatter(const Precision::_v precision = Precision::Seconds) : m_precision(precision) {;}
 
    /**
     * Fast shared creator
     */
-   static std::shared_ptr<DefaultFormatter> instantiate() {
-      return std::make_shared<DefaultFormatter>();
+   static std::shared_ptr<DefaultFormatter> instantiate(const Precision::_v precision = Precision::Seconds) {
+      return std::make_shared<DefaultFormatter>(precision);
    }
 
+   Precision::_v getPrecision() const noexcept { return m_precision; }
+
 private:
+   const Precision::_v m_precision;
+
    std::string apply(const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno) noexcept;
+   std::string apply(const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno,
+      const std::chrono::system_clock::time_point& timestamp, const pthread_t thread) noexcept;
 
 };
 
@@ -0,0 +1,179 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef __coffee_logger_Fields_hpp
+#define __coffee_logger_Fields_hpp
+
+#include <string>
+#include <type_traits>
+
+#include <string.h>
+
+#include <coffee/logger/Logger.hpp>
+
+namespace coffee {
+
+namespace logger {
+
+/**
+ * Typed key/value pairs attached to a trace. The values are kept as they are, the strings are referenced and
+ * not copied, so an instance only can be used while the trace is being written.
+ *
+ * It must be used through the macros LOG_XXX_FIELDS:
+ * \code
+ * LOG_WARN_FIELDS(("path", path)("status", 404)("elapsed", 1.5), "Servlet not found");
+ * \endcode
+ *
+ * The formatter receives them through #getCurrent, JsonFormatter writes them as JSON members and
+ * DefaultFormatter appends them as name=value.
+ *
+ * \include test/logger/JsonFormatter_test.cc
+ */
+class Fields {
+public:
+   static const int MaxSize = 16; ///< Fields added after this limit are ignored.
+
+   /**
+    * Type of every value.
+    */
+   struct Type {
+      enum _v { Signed, Unsigned, Real, Boolean, Text };
+   };
+
+   struct Field {
+      const char* name;
+      Type::_v type;
+      union {
+         int64_t integer;
+         uint64_t unsignedInteger;
+         double real;
+         bool boolean;
+      };
+      const char* text;
+      size_t length;
+   };
+
+   typedef const Field* const_iterator;
+
+   /**
+    * Constructor.
+    */
+   Fields() : m_size(0) {;}
+
+   Fields& operator()(const char* name, const bool value) noexcept {
+      if (Field* field = next(name, Type::Boolean))
+         field->boolean = value;
+      return *this;
+   }
+
+   Fields& operator()(const char* name, const char* value) noexcept {
+      if (value == nullptr)
+         value = "<null>";
+      return text(name, value, strlen(value));
+   }
+
+   Fields& operator()(const char* name, const std::string& value) noexcept {
+      return text(name, value.data(), value.size());
+   }
+
+   template <typename T>
+   typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value, Fields&>::type operator()(const char* name, const T& value) noexcept {
+      if (std::is_floating_point<T>::value) {
+         if (Field* field = next(name, Type::Real))
+            field->real = static_cast<double>(value);
+      }
+      else if (std::is_signed<T>::value || std::is_enum<T>::value) {
+         if (Field* field = next(name, Type::Signed))
+            field->integer = static_cast<int64_t>(value);
+      }
+      else {
+         if (Field* field = next(name, Type::Unsigned))
+            field->unsignedInteger = static_cast<uint64_t>(value);
+      }
+
+      return *this;
+   }
+
+   size_t size() const noexcept { return m_size; }
+   bool empty() const noexcept { return m_size == 0; }
+   const_iterator begin() const noexcept { return m_fields; }
+   const_iterator end() const noexcept { return m_fields + m_size; }
+
+   /**
+    * Appends the fields as name=value separated by spaces.
+    */
+   void appendText(std::string& output) const noexcept;
+
+   /**
+    * \return the fields attached to the trace which is being formatted by the current thread or \b nullptr
+    * if there is not any.
+    */
+   static const Fields* getCurrent() noexcept;
+
+private:
+   Field m_fields[MaxSize];
+   size_t m_size;
+
+   Field* next(const char* name, const Type::_v type) noexcept {
+      if (m_size == MaxSize)
+         return nullptr;
+
+      Field* result = &m_fields[m_size ++];
+      result->name = name;
+      result->type = type;
+      return result;
+   }
+
+   Fields& text(const char* name, const char* value, const size_t length) noexcept {
+      if (Field* field = next(name, Type::Text)) {
+         field->text = value;
+         field->length = length;
+      }
+      return *this;
+   }
+
+   static const Fields* setCurrent(const Fields* fields) noexcept;
+
+   friend class Logger;
+};
+
+}
+}
+
+#define COFFEE_LOG_FIELDS(level,fields,args)\
+   do {\
+   if(coffee::logger::Logger::wantsToProcess(level)) { \
+      coffee::logger::Fields __fields__; \
+      coffee::basis::StreamString msg; \
+      coffee::logger::Logger::write(level, msg << args, __fields__ fields, COFFEE_LOG_LOCATION); \
+   } \
+   } while(false);
+
+#define LOG_CRITICAL_FIELDS(fields,args) COFFEE_LOG_FIELDS(coffee::logger::Level::Critical, fields, args)
+#define LOG_ERROR_FIELDS(fields,args) COFFEE_LOG_FIELDS(coffee::logger::Level::Error, fields, args)
+#define LOG_WARN_FIELDS(fields,args) COFFEE_LOG_FIELDS(coffee::logger::Level::Warning, fields, args)
+#define LOG_NOTICE_FIELDS(fields,args) COFFEE_LOG_FIELDS(coffee::logger::Level::Notice, fields, args)
+#define LOG_INFO_FIELDS(fields,args) COFFEE_LOG_FIELDS(coffee::logger::Level::Information, fields, args)
+#define LOG_DEBUG_FIELDS(fields,args) COFFEE_LOG_FIELDS(coffee::logger::Level::Debug, fields, args)
+
+#endif
@@ -24,6 +24,10 @@
 #ifndef __coffee_logger_Formatter_hpp
 #define __coffee_logger_Formatter_hpp
 
+#include <chrono>
+
+#include <pthread.h>
+
 #include <coffee/logger/Level.hpp>
 
 namespace coffee {
@@ -60,6 +64,34 @@ protected:
     */
    virtual std::string apply(const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno) noexcept = 0;
 
+   /**
+    * Combines the parameters of a trace which was generated before and maybe on other thread, see logger::Record.
+    * By default the timestamp and the thread are ignored.
+    *
+    * \param timestamp Time when the trace was generated.
+    * \param thread Thread which generated the trace.
+    */
+   virtual std::string apply(const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno,
+      const std::chrono::system_clock::time_point& /*timestamp*/, const pthread_t /*thread*/) noexcept
+   {
+      return apply(level, comment, methodName, file, lineno);
+   }
+
+   /**
+    * Combines the parameters of a trace into a line which is only used until the writers have received it.
+    * By default it keeps the result of #apply in \em buffer, formatters which build the line on a buffer
+    * of the calling thread could return it, so the line is not copied.
+    *
+    * \param buffer Storage which could keep the line.
+    * \return The line to be used by the writer(s), valid until this thread formats another trace.
+    */
+   virtual const std::string& format(const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno,
+      std::string& buffer) noexcept
+   {
+      buffer = apply(level, comment, methodName, file, lineno);
+      return buffer;
+   }
+
 private:
    friend class Logger;
 
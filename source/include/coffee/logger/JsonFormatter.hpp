@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef __coffee_logger_JsonFormatter_hpp
+#define __coffee_logger_JsonFormatter_hpp
+
+#include <memory>
+
+#include <coffee/logger/Formatter.hpp>
+
+namespace coffee {
+namespace logger {
+
+/**
+ * Formatter which generates one JSON object for every trace, so the lines can be processed without parsing
+ * free text. The fields attached through LOG_XXX_FIELDS are written as members of "fields" keeping their types.
+ *
+ * \code
+{"timestamp":"2018-02-23T09:38:33.123Z","level":"Warning","thread":"0x7f0c5a3fd740","function":"service","file":"coffee/src/http/HttpService.cc","line":231,"message":"Servlet not found","fields":{"path":"/x","status":404}}
+\endcode
+ *
+ * The timestamp is written in UTC with milliseconds. The traces written through Logger::write are built on
+ * a buffer of the calling thread, which is reserved the first time and handed to the writers without copying it.
+ * The traces formatted through #apply, as the ones from logger::Record, still return a copy.
+ *
+ * \include test/logger/JsonFormatter_test.cc
+ */
+class JsonFormatter : public Formatter {
+public:
+   static const int InitialBufferSize = 1024;
+
+   /**
+    * Constructor.
+    */
+   JsonFormatter() {;}
+
+   /**
+    * Fast shared creator
+    */
+   static std::shared_ptr<JsonFormatter> instantiate() {
+      return std::make_shared<JsonFormatter>();
+   }
+
+private:
+   std::string apply(const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno) noexcept;
+   std::string apply(const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno,
+      const std::chrono::system_clock::time_point& timestamp, const pthread_t thread) noexcept;
+   const std::string& format(const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno,
+      std::string& buffer) noexcept;
+};
+
+}
+}
+#endif
@@ -24,10 +24,12 @@
 #ifndef coffee_logger_Logger_hpp
 #define coffee_logger_Logger_hpp
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
 #include <coffee/logger/Level.hpp>
+#include <coffee/logger/Record.hpp>
 
 #include <coffee/basis/RuntimeException.hpp>
 
@@ -41,15 +43,21 @@ namespace logger {
 
 class Writer;
 class Formatter;
+class AsyncWriter;
+class Fields;
 
 /**
  * Facade for the logger system. Not matter the Writer nor Formatter you will always used this interface.
  *
+ * The writers and the formatter are published as an immutable snapshot (read-copy-update). Every trace
+ * reads the current snapshot without taking locks nor touching the reference counters of the writers;
+ * #initialize and #add build a new snapshot and release the previous one once no thread is still
+ * reading it.
+ *
  * \include test/logger/filtering_test.cc
  */
 class Logger {
    typedef std::vector<std::shared_ptr<Writer> > Writers;
-   typedef Writers::iterator writer_iterator;
 
 public:
    /**
@@ -67,6 +75,7 @@ public:
    /**
     * You can attach a undefined numbers of writers to the this Logger, and all of them will received
     * the string composed by the formatter.
+    * \warning It can not be called from a Writer or a Formatter while they are processing a trace.
     */
    static void add(std::shared_ptr<Writer> writer) throw (basis::RuntimeException);
 
@@ -83,28 +92,61 @@ public:
     */
    static void write(const Level::_v level, const basis::StreamString& streamString, const char* function, const char* file, const unsigned line) noexcept;
 
+   /**
+    * Write the trace received with some typed fields attached, the formatter will get them through Fields::getCurrent.
+    * \warning Use this method through
+    * \code
+    *     LOG_INFO_FIELDS(("name", value)("other", otherValue), var1 << " some text");
+    * \endcode
+    */
+   static void write(const Level::_v level, const basis::StreamString& streamString, const Fields& fields, const char* function, const char* file, const unsigned line) noexcept;
+
+   /**
+    * Write a binary trace. The values are stored without formatting and the message will be built only
+    * when some writer needs it, see Writer::applyRecord.
+    * \warning Use this method through
+    * \code
+    *     LOG_RECORD(Level::Debug, "value {} of {}", var1, var2);
+    * \endcode
+    */
+   template <typename... Args> static void write(const RecordSite& site, const Args&... args) noexcept {
+      Record& record = Record::getThreadRecord();
+      record.encode(site, args...);
+      write(record);
+   }
+
+   /**
+    * Write the binary trace received.
+    */
+   static void write(const Record& record) noexcept;
+
    /**
     * Change the current level. Only traces with a level smaller that this level will be traced.
     */
-   static void setLevel(const Level::_v level) noexcept { m_level = level; }
+   static void setLevel(const Level::_v level) noexcept;
 
    /**
     * \return Get current level.
     */
-   static Level::_v getLevel() noexcept { return m_level; }
+   static Level::_v getLevel() noexcept { return m_level.load(std::memory_order_relaxed); }
 
    /**
     * \return \b true if a trace using this the received level would be traced (taking account of the current level) or \b false otherwise.
     */
-   static bool isActive(const Level::_v level) noexcept { return(level <= Level::Error) ? true:(level <= m_level); }
+   static bool isActive(const Level::_v level) noexcept { return(level <= Level::Error) ? true:(level <= getLevel()); }
 
    /**
     * \return \b true if some associated writer would process the received trace or \b false otherwise.
     * Think about BacktraceWriter which wants to process all levels but it will not write anything till the
     * moment a error trace is detected.
     * \warning It is possible that a writer process some trace but it will not "write" anything by now.
+    *
+    * The answer comes from a mask with the levels accepted by the writers, it is recalculated when the
+    * writers or the levels change, so a disabled trace costs only one load and one branch.
     */
-   static bool wantsToProcess(const Level::_v level) noexcept;
+   static bool wantsToProcess(const Level::_v level) noexcept {
+      return (m_levelMask.load(std::memory_order_relaxed) & (1u << (level + 1))) != 0;
+   }
 
    /**
     * Send a trace with level Level::Critical to attached writers.
@@ -171,12 +213,21 @@ public:
    }
 
 private:
-   static Level::_v m_level;
-   static Writers m_writers;
-   static std::shared_ptr<Formatter> m_formatter;
+   struct Snapshot;
+
+   static std::atomic<Level::_v> m_level;
+   static std::atomic<const Snapshot*> m_snapshot;
+   static std::atomic<unsigned> m_levelMask;
+
+   static void publish(const Snapshot* snapshot) throw(basis::RuntimeException);
+   static void refreshLevelMask() noexcept;
+   static void format(const std::string& record, std::string& output) noexcept;
 
    Logger() = delete;
    Logger(const Logger&) = delete;
+
+   friend class Writer;
+   friend class AsyncWriter;
 };
 
 #ifdef COFFEE_LOG_LOCATION
@@ -240,6 +291,14 @@ private:
    } \
    } while(false);
 
+#define LOG_RECORD(level,format,...)\
+   do {\
+   if(coffee::logger::Logger::wantsToProcess(level)) { \
+      static const coffee::logger::RecordSite __recordSite__(level, format, COFFEE_LOG_LOCATION); \
+      coffee::logger::Logger::write(__recordSite__, ##__VA_ARGS__); \
+   } \
+   } while(false);
+
 }
 }
 
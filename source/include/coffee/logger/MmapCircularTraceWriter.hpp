@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef __coffee_logger_MmapCircularTraceWriter_hpp
+#define __coffee_logger_MmapCircularTraceWriter_hpp
+
+#include <atomic>
+#include <memory>
+
+#include <coffee/logger/Writer.hpp>
+
+namespace coffee {
+
+namespace logger {
+
+/**
+ * It stores traces in a file of fixed size which is mapped into memory and used as a ring, so writing a
+ * line is only a memory copy and the file never needs to be rotated.
+ *
+ * The file starts with a header which keeps the total number of bytes written, the lines follow the header
+ * and the newest ones overwrite the oldest ones. The pages belong to the file, so the last lines survive
+ * even if the process crashes, use #extract to get them in order.
+ *
+ * Many threads could write at the same time, every line reserves its room with an atomic operation.
+ *
+ * \include test/logger/MmapCircularTraceWriter_test.cc
+ */
+class MmapCircularTraceWriter : public Writer {
+public:
+   static const int MinimalKbSize = 64;
+   static const int HeaderSize = 64; ///< Bytes reserved at the beginning of the file.
+
+   /**
+    * Constructor.
+    * \param path file path to store the traces.
+    * \param maxKbSize Size of the ring expressed in KBytes.
+    */
+   MmapCircularTraceWriter(const std::string& path, const size_t maxKbSize);
+
+   /**
+    * Destructor.
+    */
+   virtual ~MmapCircularTraceWriter() { unmap(); }
+
+   static std::shared_ptr<MmapCircularTraceWriter> instantiate(const std::string& path, const size_t maxKbSize) {
+      return std::make_shared<MmapCircularTraceWriter>(path, maxKbSize);
+   }
+
+   bool isMapped() const noexcept { return m_header != nullptr; }
+   size_t getKbytesMaxSize() const noexcept { return m_capacity; }
+
+   /**
+    * \return total number of bytes written over the file, including the ones already overwritten.
+    */
+   uint64_t getPosition() const noexcept;
+
+   /**
+    * \return how many times the ring has been completed.
+    */
+   unsigned int getLoops() const noexcept { return getPosition() / m_capacity; }
+
+   /**
+    * Reads a file generated by this writer, even from a process which has finished abnormally.
+    * \return the lines stored in the file from the oldest to the newest one.
+    */
+   static std::string extract(const std::string& path) throw(basis::RuntimeException);
+
+protected:
+   void apply(const Level::_v level, const std::string& line) noexcept;
+   bool wantsToProcess(const Level::_v level) const noexcept;
+
+private:
+   struct Header;
+
+   const std::string m_path;
+   const size_t m_capacity;
+   Header* m_header;
+   char* m_data;
+
+   void initialize() throw(basis::RuntimeException);
+   void copy(uint64_t position, const char* data, size_t size) noexcept;
+   void unmap() noexcept;
+};
+
+}
+}
+
+#endif
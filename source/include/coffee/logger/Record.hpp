@@ -0,0 +1,195 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef __coffee_logger_Record_hpp
+#define __coffee_logger_Record_hpp
+
+#include <chrono>
+#include <string>
+#include <type_traits>
+
+#include <pthread.h>
+
+#include <coffee/basis/StreamString.hpp>
+
+#include <coffee/logger/Level.hpp>
+
+namespace coffee {
+
+namespace logger {
+
+/**
+ * Static information about the place where a binary trace is generated. Every site receives an unique
+ * identifier the first time it is used, so the records only need to carry that identifier and the raw values.
+ *
+ * It must be used through the LOG_RECORD macro.
+ */
+class RecordSite {
+public:
+   /**
+    * Constructor.
+    * \param level Level of the traces generated on this site.
+    * \param format Literal used to build the message, every "{}" will be replaced by the next value.
+    * \param function method name where the trace was created
+    * \param file The file where the trace was created
+    * \param line The line number where the trace was created.
+    */
+   RecordSite(const Level::_v level, const char* format, const char* function, const char* file, const unsigned line) noexcept;
+
+   unsigned getId() const noexcept { return m_id; }
+   Level::_v getLevel() const noexcept { return m_level; }
+   const char* getFormat() const noexcept { return m_format; }
+   const char* getFunction() const noexcept { return m_function; }
+   const char* getFile() const noexcept { return m_file; }
+   unsigned getLine() const noexcept { return m_line; }
+
+   /**
+    * \return the site with the received identifier or \b nullptr if there is not any.
+    */
+   static const RecordSite* find(const unsigned id) noexcept;
+
+private:
+   const Level::_v m_level;
+   const char* m_format;
+   const char* m_function;
+   const char* m_file;
+   const unsigned m_line;
+   unsigned m_id;
+
+   RecordSite(const RecordSite&) = delete;
+   RecordSite& operator=(const RecordSite&) = delete;
+};
+
+/**
+ * Binary trace which keeps the identifier of its RecordSite and the raw values of its arguments. The
+ * message is only built when some writer needs it, that could be done by the AsyncWriter thread.
+ *
+ * The layout is the site identifier, the timestamp in nanoseconds and the thread followed by every value
+ * as a type byte and its raw bytes. Types without a native encoding are converted to text through
+ * basis::StreamString while the record is generated.
+ *
+ * \include test/logger/Record_test.cc
+ */
+class Record {
+public:
+   /**
+    * Encoding of every value.
+    */
+   struct Type {
+      enum _v { Signed, Unsigned, Real, Boolean, Character, Text };
+   };
+
+   /**
+    * Fixed data of every record.
+    */
+   struct Header {
+      const RecordSite* site;
+      std::chrono::system_clock::time_point timestamp;
+      pthread_t thread;
+   };
+
+   /**
+    * Constructor.
+    */
+   Record() : m_site(nullptr) {;}
+
+   /**
+    * Replaces the content of this record with the values received as parameter.
+    */
+   template <typename... Args> void encode(const RecordSite& site, const Args&... args) noexcept {
+      m_site = &site;
+      m_buffer.clear();
+      putHeader(site);
+      put(args...);
+   }
+
+   const RecordSite* getSite() const noexcept { return m_site; }
+   const std::string& getData() const noexcept { return m_buffer; }
+
+   /**
+    * \return the record used by the current thread to avoid allocations.
+    */
+   static Record& getThreadRecord() noexcept;
+
+   /**
+    * Decodes the binary record and builds the message replacing every "{}" of the site format by its value.
+    * Values without placeholder are appended at the end of the message.
+    * \return \b true if the record is valid or \b false otherwise.
+    */
+   static bool decode(const char* data, const size_t size, Header& header, basis::StreamString& message) noexcept;
+
+private:
+   const RecordSite* m_site;
+   std::string m_buffer;
+
+   void put() noexcept {;}
+
+   template <typename T, typename... Args> void put(const T& value, const Args&... args) noexcept {
+      putValue(value);
+      put(args...);
+   }
+
+   void putHeader(const RecordSite& site) noexcept;
+
+   void putValue(const bool value) noexcept { putType(Type::Boolean); m_buffer.push_back(value ? 1: 0); }
+   void putValue(const char value) noexcept { putType(Type::Character); m_buffer.push_back(value); }
+   void putValue(const char* value) noexcept;
+   void putValue(const std::string& value) noexcept { putText(value.data(), value.size()); }
+
+   template <typename T> void putValue(const T& value) noexcept {
+      putValue(value, std::integral_constant<bool, std::is_arithmetic<T>::value>());
+   }
+
+   template <typename T> void putValue(const T& value, std::true_type) noexcept {
+      if (std::is_floating_point<T>::value) {
+         const double real = static_cast<double>(value);
+         putType(Type::Real);
+         putRaw(&real, sizeof(real));
+      }
+      else if (std::is_signed<T>::value) {
+         const int64_t integer = static_cast<int64_t>(value);
+         putType(Type::Signed);
+         putRaw(&integer, sizeof(integer));
+      }
+      else {
+         const uint64_t integer = static_cast<uint64_t>(value);
+         putType(Type::Unsigned);
+         putRaw(&integer, sizeof(integer));
+      }
+   }
+
+   template <typename T> void putValue(const T& value, std::false_type) noexcept {
+      basis::StreamString text;
+      text << value;
+      putText(text.data(), text.size());
+   }
+
+   void putType(const Type::_v type) noexcept { m_buffer.push_back((char) type); }
+   void putRaw(const void* data, const size_t size) noexcept { m_buffer.append((const char*) data, size); }
+   void putText(const char* data, const size_t size) noexcept;
+};
+
+}
+}
+
+#endif
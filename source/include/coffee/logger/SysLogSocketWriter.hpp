@@ -0,0 +1,107 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef __coffee_logger_SysLogSocketWriter_hpp
+#define __coffee_logger_SysLogSocketWriter_hpp
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <coffee/logger/Writer.hpp>
+
+namespace coffee {
+
+namespace logger {
+
+/**
+ * This writer sends the traces directly to the local syslog socket, without using libc syslog() which
+ * takes a global lock and could block while the syslog daemon is busy.
+ *
+ * Every trace is sent as one datagram with non-blocking calls. When the socket buffer is full the trace is
+ * discarded and counted instead of stalling the calling thread. When it is used through AsyncWriter every
+ * batch of traces is sent with only one sendmmsg call.
+ *
+ * \code
+ * auto writer = logger::AsyncWriter::instantiate(logger::SysLogSocketWriter::instantiate("my-service"), 4096);
+ * logger::Logger::initialize(writer);
+ * \endcode
+ *
+ * \include test/logger/SysLogSocketWriter_test.cc
+ */
+class SysLogSocketWriter : public Writer {
+public:
+   static const int NullStream;
+   static const int MaxMessageSize = 8192; ///< Longer traces will be truncated.
+   static const int MaxBatchLines = 64; ///< Max number of traces sent by every system call.
+   static const int DefaultFacility = 1 << 3; ///< LOG_USER
+   static const char* DefaultPath;
+
+   /**
+    * Constructor.
+    * \param ident The string is prepended to every message, it is typically set to the program name.
+    * \param path Path of the local syslog socket.
+    * \param facility Syslog facility already shifted, as the LOG_XXX values of syslog.h.
+    */
+   SysLogSocketWriter(const std::string& ident, const std::string& path = DefaultPath, const int facility = DefaultFacility);
+
+   /**
+    * Destructor.
+    */
+   ~SysLogSocketWriter();
+
+   static std::shared_ptr<SysLogSocketWriter> instantiate(const std::string& ident, const std::string& path = DefaultPath, const int facility = DefaultFacility) {
+      return std::make_shared<SysLogSocketWriter>(ident, path, facility);
+   }
+
+   int getStream() const noexcept { return m_stream; }
+   unsigned int getSentCounter() const noexcept { return m_sentCounter.load(std::memory_order_relaxed); }
+   unsigned int getDroppedCounter() const noexcept { return m_droppedCounter.load(std::memory_order_relaxed); }
+
+protected:
+   void apply(const Level::_v level, const std::string& line) noexcept;
+   void applyBatch(const Line* lines, const size_t size) noexcept;
+   bool wantsToProcess(const Level::_v level) const noexcept;
+
+private:
+   const std::string m_ident;
+   const std::string m_path;
+   const int m_facility;
+   std::string m_tag;
+   std::string m_priorities[8];
+   int m_stream;
+   std::atomic<unsigned int> m_sentCounter;
+   std::atomic<unsigned int> m_droppedCounter;
+   std::mutex m_mutex;
+
+   void initialize() throw(basis::RuntimeException);
+   void connect() throw(basis::RuntimeException);
+   bool reconnect() noexcept;
+   void closeStream() noexcept;
+   const std::string& getPriority(const Level::_v level) const noexcept;
+};
+
+}
+}
+
+#endif
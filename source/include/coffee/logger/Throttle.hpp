@@ -0,0 +1,161 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef __coffee_logger_Throttle_hpp
+#define __coffee_logger_Throttle_hpp
+
+#include <atomic>
+#include <chrono>
+
+#include <coffee/logger/Logger.hpp>
+
+namespace coffee {
+
+namespace logger {
+
+/**
+ * Limits the number of traces written by one call site, to avoid that a hot error path floods the writers.
+ * Every site keeps its own counters and they are updated without locks.
+ *
+ * It must be used through the macros LOG_XXX_EVERY_N, LOG_XXX_RATE and LOG_XXX_FIRST_N:
+ * \code
+ * LOG_ERROR_RATE(10, path << " was not service for any servlet");
+ * LOG_WARN_EVERY_N(100, "Queue is full");
+ * LOG_INFO_FIRST_N(5, "Deprecated parameter " << name);
+ * \endcode
+ *
+ * The trace written after some suppressed ones tells how many were suppressed, and once every
+ * #SummaryPeriod a site which is suppressing all its traces writes a summary.
+ *
+ * \include test/logger/Throttle_test.cc
+ */
+class Throttle {
+public:
+   /**
+    * How the traces are selected.
+    */
+   struct Mode {
+      enum _v {
+         EveryN, ///< Only one of every N traces is written.
+         Rate, ///< At most N traces per second are written.
+         FirstN ///< Only the first N traces are written.
+      };
+      static const char* asString(const Mode::_v value) noexcept;
+   };
+
+   static const std::chrono::seconds SummaryPeriod;
+
+   /**
+    * Constructor.
+    * \param mode Selection used by this site.
+    * \param value Parameter N of the selected mode.
+    * \param summaryPeriod Minimal time between two summaries.
+    */
+   Throttle(const Mode::_v mode, const unsigned value, const std::chrono::milliseconds& summaryPeriod = SummaryPeriod) noexcept;
+
+   Mode::_v getMode() const noexcept { return m_mode; }
+   unsigned getValue() const noexcept { return m_value; }
+
+   /**
+    * \param suppressed Will receive the number of traces suppressed since the last one written.
+    * \return \b true if the trace has to be written or \b false otherwise.
+    */
+   bool accept(unsigned& suppressed) noexcept;
+
+   /**
+    * Called for traces which have not been accepted.
+    * \param suppressed Will receive the number of traces suppressed since the last one written.
+    * \return \b true if a summary has to be written or \b false otherwise.
+    */
+   bool summarize(unsigned& suppressed) noexcept;
+
+   /**
+    * Writes the trace accepted by the site and appends the number of suppressed traces.
+    */
+   static void write(const Level::_v level, basis::StreamString& message, const unsigned suppressed, const char* function, const char* file, const unsigned line) noexcept;
+
+   /**
+    * Writes the periodic summary of the site.
+    */
+   static void writeSummary(const Level::_v level, const unsigned suppressed, const char* function, const char* file, const unsigned line) noexcept;
+
+private:
+   const Mode::_v m_mode;
+   const unsigned m_value;
+   const int64_t m_interval;
+   const int64_t m_summaryPeriod;
+   std::atomic<unsigned> m_counter;
+   std::atomic<unsigned> m_suppressed;
+   std::atomic<int64_t> m_theoreticalArrival;
+   std::atomic<int64_t> m_lastSummary;
+
+   bool select() noexcept;
+
+   static int64_t now() noexcept {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   Throttle(const Throttle&) = delete;
+   Throttle& operator=(const Throttle&) = delete;
+};
+
+}
+}
+
+#define COFFEE_LOG_THROTTLED(level,mode,value,args)\
+   do {\
+   if(coffee::logger::Logger::wantsToProcess(level)) { \
+      static coffee::logger::Throttle __throttle__(coffee::logger::Throttle::Mode::mode, value); \
+      unsigned __suppressed__; \
+      if (__throttle__.accept(__suppressed__)) { \
+         coffee::basis::StreamString msg; \
+         coffee::logger::Throttle::write(level, msg << args, __suppressed__, COFFEE_LOG_LOCATION); \
+      } \
+      else if (__throttle__.summarize(__suppressed__)) { \
+         coffee::logger::Throttle::writeSummary(level, __suppressed__, COFFEE_LOG_LOCATION); \
+      } \
+   } \
+   } while(false);
+
+#define LOG_CRITICAL_EVERY_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Critical, EveryN, n, args)
+#define LOG_ERROR_EVERY_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Error, EveryN, n, args)
+#define LOG_WARN_EVERY_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Warning, EveryN, n, args)
+#define LOG_NOTICE_EVERY_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Notice, EveryN, n, args)
+#define LOG_INFO_EVERY_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Information, EveryN, n, args)
+#define LOG_DEBUG_EVERY_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Debug, EveryN, n, args)
+
+#define LOG_CRITICAL_RATE(perSecond,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Critical, Rate, perSecond, args)
+#define LOG_ERROR_RATE(perSecond,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Error, Rate, perSecond, args)
+#define LOG_WARN_RATE(perSecond,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Warning, Rate, perSecond, args)
+#define LOG_NOTICE_RATE(perSecond,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Notice, Rate, perSecond, args)
+#define LOG_INFO_RATE(perSecond,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Information, Rate, perSecond, args)
+#define LOG_DEBUG_RATE(perSecond,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Debug, Rate, perSecond, args)
+
+#define LOG_CRITICAL_FIRST_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Critical, FirstN, n, args)
+#define LOG_ERROR_FIRST_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Error, FirstN, n, args)
+#define LOG_WARN_FIRST_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Warning, FirstN, n, args)
+#define LOG_NOTICE_FIRST_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Notice, FirstN, n, args)
+#define LOG_INFO_FIRST_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Information, FirstN, n, args)
+#define LOG_DEBUG_FIRST_N(n,args) COFFEE_LOG_THROTTLED(coffee::logger::Level::Debug, FirstN, n, args)
+
+#endif
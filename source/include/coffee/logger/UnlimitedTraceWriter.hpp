@@ -64,6 +64,7 @@ public:
 protected:
    void apply (const Level::_v level, const std::string& line) noexcept;
    bool wantsToProcess (const Level::_v level) const noexcept;
+   void applyBatch(const Line* lines, const size_t size) noexcept;
 
 private:
    const std::string m_path;
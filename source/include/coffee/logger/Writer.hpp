@@ -24,6 +24,9 @@
 #ifndef coffee_logger_Writer_hpp
 #define coffee_logger_Writer_hpp
 
+#include <string>
+#include <utility>
+
 #include <coffee/logger/Level.hpp>
 #include <coffee/basis/RuntimeException.hpp>
 
@@ -32,6 +35,8 @@ namespace coffee {
 namespace logger {
 
 class Logger;
+class AsyncWriter;
+class Record;
 
 /**
  * Generic writer of traces.
@@ -43,6 +48,8 @@ public:
     */
    virtual ~Writer() {;}
 
+   typedef std::pair<Level::_v, std::string> Line;
+
 protected:
    /**
     * constructor.
@@ -55,6 +62,38 @@ protected:
     */
    virtual bool wantsToProcess(const Level::_v level) const noexcept;
 
+   /**
+    * Writes a group of lines already accepted by #wantsToProcess. By default it calls #apply for every line,
+    * writers based on file descriptors could write all of them with only one system call.
+    */
+   virtual void applyBatch(const Line* lines, const size_t size) noexcept;
+
+   /**
+    * Writes the line followed by a new line on the file descriptor, resuming the partial writes.
+    * \return \b false if the system call failed, the error is kept on errno.
+    */
+   static bool writeLine(const int stream, const std::string& line) noexcept;
+
+   /**
+    * Writes the lines, every one followed by a new line, on the file descriptor with as few system
+    * calls as possible, resuming the partial writes.
+    * \return \b false if some system call failed, the error is kept on errno.
+    */
+   static bool writeLines(const int stream, const Line* lines, const size_t size) noexcept;
+
+   /**
+    * Must be called when the answer of #wantsToProcess changes for some level, the Logger keeps
+    * a cached mask with the levels accepted by all its writers.
+    */
+   void levelsChanged() const noexcept;
+
+   /**
+    * Receives a binary trace generated through LOG_RECORD. Writers which are able to defer the formatting
+    * keep the record and return \b true, by default it returns \b false and the Logger will call #apply with
+    * the formatted line.
+    */
+   virtual bool applyRecord(const Level::_v /*level*/, const Record& /*record*/) noexcept { return false; }
+
 private:
    const std::string m_name;
 
@@ -64,6 +103,7 @@ private:
    virtual void apply(const Level::_v level, const std::string& line) noexcept = 0;
 
    friend class Logger;
+   friend class AsyncWriter;
 };
 
 }
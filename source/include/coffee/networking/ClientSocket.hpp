@@ -30,6 +30,10 @@
 
 namespace coffee {
 
+namespace time {
+class Deadline;
+}
+
 namespace networking {
 
 class MessageHandler;
@@ -38,6 +42,13 @@ class ClientSocket : public Socket {
 public:
    basis::DataBlock send(const basis::DataBlock& request) throw(basis::RuntimeException);
 
+   /**
+    * Sends the request and waits for the response until the deadline expires, instead of the
+    * default receive timeout. The same deadline could be shared by several requests.
+    * \warning A response received after the deadline is discarded.
+    */
+   basis::DataBlock send(const basis::DataBlock& request, const std::shared_ptr<time::Deadline>& deadline) throw(basis::RuntimeException);
+
    basis::StreamString asString() const noexcept;
 
 protected:
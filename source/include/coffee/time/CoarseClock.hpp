@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_time_CoarseClock_hpp_
+#define _coffee_time_CoarseClock_hpp_
+
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+
+namespace coffee {
+
+namespace time {
+
+/**
+ * Wall clock with precision of milliseconds for code which reads the time very often but does not need
+ * more accuracy than a few milliseconds, for example the timestamps of the traces.
+ *
+ * While there is some TimeService with a resolution lesser or equal than #MaxDriverResolution
+ * and with workers running, it publishes the current time on every tick and #now only has to do
+ * one atomic load.
+ * Otherwise it reads CLOCK_REALTIME_COARSE, which is updated by the kernel on every jiffy.
+ *
+ * It is header only, so it could be used by modules which do not link with the time library.
+ */
+class CoarseClock {
+public:
+   typedef std::chrono::milliseconds duration;
+   typedef duration::rep rep;
+   typedef duration::period period;
+   typedef std::chrono::time_point<std::chrono::system_clock, duration> time_point;
+
+   static const bool is_steady = false;
+
+   /**
+    * Longest resolution of a TimeService which could drive this clock.
+    */
+   static std::chrono::milliseconds getMaxDriverResolution() noexcept { return std::chrono::milliseconds(10); }
+
+   /**
+    * \return The current time, with an error up to the resolution of the driver.
+    */
+   static time_point now() noexcept {
+      const rep published = value().load(std::memory_order_relaxed);
+
+      if (published != 0)
+         return time_point(duration(published));
+
+      timespec ts;
+      clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+      return time_point(duration(rep(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000));
+   }
+
+   /**
+    * \return \b true if some driver is publishing the time or \b false otherwise.
+    */
+   static bool isDriven() noexcept { return drivers().load(std::memory_order_relaxed) > 0; }
+
+   /**
+    * Registers a new driver, it should call #update at least once every #getMaxDriverResolution.
+    */
+   static void attach() noexcept {
+      if (drivers().fetch_add(1) == 0)
+         update();
+   }
+
+   /**
+    * Unregisters a driver, once the last one is gone #now reads the time from the kernel again.
+    */
+   static void detach() noexcept {
+      if (drivers().fetch_sub(1) == 1)
+         value().store(0, std::memory_order_relaxed);
+   }
+
+   /**
+    * Publishes the current time. It is called by the drivers.
+    */
+   static void update() noexcept {
+      const auto current = std::chrono::duration_cast<duration>(std::chrono::system_clock::now().time_since_epoch());
+      value().store(current.count(), std::memory_order_relaxed);
+   }
+
+private:
+   // Function local statics keep the storage unique without requiring a translation unit
+   static std::atomic<rep>& value() noexcept { static std::atomic<rep> result(0); return result; }
+   static std::atomic<int>& drivers() noexcept { static std::atomic<int> result(0); return result; }
+};
+
+}
+}
+
+#endif /* _coffee_time_CoarseClock_hpp_ */
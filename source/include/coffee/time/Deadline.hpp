@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_time_Deadline_hpp_
+#define _coffee_time_Deadline_hpp_
+
+#include <atomic>
+#include <memory>
+
+#include <coffee/time/TimeEvent.hpp>
+
+namespace coffee {
+namespace time {
+
+class TimeService;
+
+/**
+ * Time limit for one or several requests, tracked by the timing wheel of the TimeService.
+ *
+ * It is activated when it is created and once it expires the file descriptor returned by #getFileDescriptor
+ * becomes readable, so the code waiting for a response could poll it together with its own sockets
+ * and fail the pending requests without waiting for any other timeout. The observers of
+ * the TimeService are not notified about deadlines.
+ *
+ * It should be cancelled once the requests have finished to release its position on the wheel.
+ *
+ * Every deadline receives a different identifier, so they could be told apart on the traces.
+ */
+class Deadline : public TimeEvent, public std::enable_shared_from_this<Deadline> {
+public:
+   /**
+    * Creates the deadline and activates it on the time service.
+    * \param timeService Service which will track the deadline.
+    * \param timeout Time available since now.
+    */
+   static std::shared_ptr<Deadline> instantiate(TimeService& timeService, const std::chrono::milliseconds& timeout)
+      throw(basis::RuntimeException);
+
+   /**
+    * Destructor.
+    */
+   ~Deadline();
+
+   /**
+    * \return \b true if the time service has expired this deadline or its time has already been consumed.
+    */
+   bool isExpired() const noexcept;
+
+   /**
+    * \return Time available until the deadline, zero once it has been consumed.
+    */
+   std::chrono::milliseconds getRemaining() const noexcept;
+
+   /**
+    * \return File descriptor which becomes readable once the time service expires this deadline.
+    */
+   int getFileDescriptor() const noexcept { return eventFd; }
+
+   /**
+    * Cancels this deadline on the time service, it should be called once the requests have finished.
+    */
+   void cancel() noexcept;
+
+   /**
+    * \return Summarize information of the instance
+    */
+   basis::StreamString asString() const noexcept;
+
+protected:
+   bool expire() noexcept;
+
+private:
+   TimeService& timeService;
+   const std::chrono::steady_clock::time_point limit;
+   std::atomic<bool> expired;
+   int eventFd;
+
+   Deadline(TimeService& timeService, const std::chrono::milliseconds& timeout) throw(basis::RuntimeException);
+
+   bool isPeriodical() const noexcept { return false; }
+};
+
+}
+}
+
+#endif /* _coffee_time_Deadline_hpp_ */
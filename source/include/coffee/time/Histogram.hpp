@@ -0,0 +1,129 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_time_Histogram_hpp_
+#define _coffee_time_Histogram_hpp_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <coffee/basis/RuntimeException.hpp>
+#include <coffee/basis/StreamString.hpp>
+
+namespace coffee {
+
+namespace xml {
+class Node;
+}
+
+namespace time {
+
+/**
+ * Distribution of durations on buckets of powers of two microseconds.
+ *
+ * The bucket 0 counts the values lesser than 1 us and the bucket N the values in [2^(N-1), 2^N) us.
+ * It could be updated from any thread without locks, the percentiles are approximated to the
+ * upper bound of the bucket which contains them.
+ */
+class Histogram {
+public:
+   static const int MaxBuckets = 40;
+
+   /**
+    * Constructor.
+    * \param name Name used to identify this histogram.
+    */
+   explicit Histogram(const std::string& name);
+
+   /**
+    * \return The name of this instance.
+    */
+   const std::string& getName() const noexcept { return name; }
+
+   /**
+    * Register a new value.
+    */
+   void add(const std::chrono::microseconds& value) noexcept;
+
+   /**
+    * \return Number of registered values.
+    */
+   uint64_t getCounter() const noexcept { return counter.load(std::memory_order_relaxed); }
+
+   /**
+    * \return Sum of the registered values.
+    */
+   std::chrono::microseconds getSum() const noexcept { return std::chrono::microseconds(sum.load(std::memory_order_relaxed)); }
+
+   /**
+    * \return The greatest registered value.
+    */
+   std::chrono::microseconds getMax() const noexcept { return std::chrono::microseconds(max.load(std::memory_order_relaxed)); }
+
+   /**
+    * \return The average of the registered values.
+    */
+   std::chrono::microseconds getAverage() const noexcept;
+
+   /**
+    * \return Upper bound of the bucket which contains the percentile received as parameter.
+    * \param percentile Value between 0 and 100.
+    */
+   std::chrono::microseconds getPercentile(const double percentile) const noexcept;
+
+   /**
+    * \return Number of values registered on the bucket.
+    */
+   uint64_t getBucketCounter(const int bucket) const noexcept { return buckets[bucket].load(std::memory_order_relaxed); }
+
+   /**
+    * \return Upper bound (not included) of the bucket.
+    */
+   static std::chrono::microseconds getUpperBound(const int bucket) noexcept { return std::chrono::microseconds(int64_t(1) << bucket); }
+
+   /**
+    * \return Summarize information of the instance
+    */
+   basis::StreamString asString() const noexcept;
+
+   /**
+    * \return Summarize information of the instance as a XML node, with a child for every non empty bucket.
+    */
+   std::shared_ptr<xml::Node> asXML(std::shared_ptr<xml::Node>& parent) const throw(basis::RuntimeException);
+
+private:
+   const std::string name;
+   std::atomic<uint64_t> counter;
+   std::atomic<uint64_t> sum;
+   std::atomic<uint64_t> max;
+   std::atomic<uint64_t> buckets[MaxBuckets];
+
+   static int calculeBucket(const uint64_t value) noexcept;
+};
+
+}
+}
+
+#endif /* _coffee_time_Histogram_hpp_ */
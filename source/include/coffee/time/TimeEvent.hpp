@@ -24,6 +24,8 @@
 #ifndef _coffee_time_TimeEvent_hpp_
 #define _coffee_time_TimeEvent_hpp_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <chrono>
 
@@ -60,6 +62,11 @@ public:
     */
    bool isFinished() const throw () { return endTime.count() != 0; }
 
+   /**
+    * \return \b true if the event is waiting into the TimeService.
+    */
+   bool isActivated() const noexcept { return quantum != nullptr || pending; }
+
    /**
     * \return The final duration of this event.
     * \warning It should not be valid until #isFinished returns \b true
@@ -84,10 +91,32 @@ protected:
     */
    TimeEvent(const Id id, const std::chrono::milliseconds& timeout);
 
+   /**
+    * It is called by the TimeService once this event has expired, before notifying the observers.
+    * \return \b true if the observers of the TimeService should be notified or \b false otherwise.
+    */
+   virtual bool expire() noexcept { return true; }
+
 private:
    const std::chrono::milliseconds timeout;
    std::chrono::milliseconds initTime;
    std::chrono::milliseconds endTime;
+   uint64_t expiration;
+   std::chrono::steady_clock::time_point deadline;
+
+   // Intrusive links to the quantum of the TimeService which contains this event
+   TimeEvent* previous;
+   TimeEvent* next;
+   TimeEvent** quantum;
+
+   // Shard of the TimeService where it was activated
+   std::atomic<int> shard;
+
+   // The periodical event is being notified and it will be stored again
+   bool pending;
+
+   // Keeps alive this event while it is activated
+   std::shared_ptr<TimeEvent> self;
 
    friend class TimeService;
 };
@@ -24,17 +24,17 @@
 #ifndef _coffee_time_TimeService_hpp_
 #define _coffee_time_TimeService_hpp_
 
-#include <list>
+#include <atomic>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 #include <mutex>
-#include <condition_variable>
 #include <thread>
 #include <chrono>
 
 #include <coffee/app/Service.hpp>
 #include <coffee/basis/pattern/observer/Subject.hpp>
 #include <coffee/time/TimeEvent.hpp>
+#include <coffee/time/Histogram.hpp>
 
 namespace coffee {
 
@@ -44,15 +44,63 @@ class TimeEvent;
 
 /**
  * Service for managing asynchronous time events.
+ *
+ * Time events are kept on a hierarchical timing wheel. The first level has one quantum for every tick
+ * of the resolution and every upper level has #LevelSize quantums, each one of them covering a whole
+ * turn of the previous level. When a level completes its turn the next quantum of the upper level is
+ * cascaded down, so the memory depends on the number of levels and the activated events, not on
+ * the relation between the max time and the resolution.
+ *
+ * Every quantum is an intrusive list of TimeEvent, so activating or cancelling an event only
+ * links or unlinks it without allocating memory.
+ *
+ * The ticks are driven by a timer with absolute expirations on the monotonic clock, every time it
+ * wakes up it processes all quantums elapsed since the start, so a delayed wake up does not
+ * accumulate drift.
+ *
+ * The service could be divided in shards, every one of them with its own wheel, lock, timer and thread.
+ * Time events are activated on the shard assigned to the calling thread, so threads activating
+ * events at the same time do not compete for the same lock. Observers are notified without holding
+ * any lock, so they could activate or cancel events.
+ *
+ * The notifications could be delivered by a pool of workers instead of the consumer of the shard, so
+ * a slow observer does not delay the following time events. Every observer is always notified by
+ * the same worker, so it receives its events in order.
+ *
+ * It keeps the distribution of the lateness of the expirations, the time spent processing every
+ * quantum and the time spent by the observers, see #asXML.
+ *
+ * When the resolution is fine enough and the observers are notified by workers, the first shard
+ * publishes the time on the CoarseClock every tick.
  */
 class TimeService : public app::Service, public basis::pattern::observer::Subject {
 public:
    static const std::string Implementation;
 
+   /**
+    * Number of bits of the tick used to select the quantum of the first level.
+    */
+   static const int FirstLevelBits = 8;
+
+   /**
+    * Number of bits of the tick used to select the quantum of every upper level.
+    */
+   static const int LevelBits = 6;
+
+   static const int FirstLevelSize = 1 << FirstLevelBits;
+   static const int LevelSize = 1 << LevelBits;
+
    /**
     * Fast instantiation for this service.
+    * \param maxTime Longest timeout expected. It is used to calculate the number of levels of the wheel,
+    * longer timeouts are accepted too but they will be re-scheduled on the last level until they expire.
+    * \param resolution Duration of every tick. Timeouts lesser than it will expire on the next tick.
+    * \param shards Number of independent wheels, usually one for every worker thread.
+    * \param workers Number of threads used to notify the observers. With 0 they are notified by the
+    * consumer of the shard. With workers a periodical event could have been stored again when its
+    * observer is notified.
     */
-   static std::shared_ptr<TimeService> instantiate(app::Application& application, const std::chrono::milliseconds& maxTime, const std::chrono::milliseconds& resolution)
+   static std::shared_ptr<TimeService> instantiate(app::Application& application, const std::chrono::milliseconds& maxTime, const std::chrono::milliseconds& resolution, const int shards = 1, const int workers = 0)
       throw(basis::RuntimeException);
 
    /**
@@ -86,46 +134,109 @@ public:
    /**
     * \return \b true if there is not any event activated or \b false otherwise.
     */
-   bool empty() const noexcept { return events.empty(); }
+   bool empty() const noexcept { return size() == 0; }
 
    /**
     * \return Numbers of activated time events.
     */
-   size_t size() const noexcept { return events.size(); }
+   size_t size() const noexcept;
+
+   /**
+    * \return Number of levels of the timing wheel.
+    */
+   int getLevels() const noexcept { return levels; }
+
+   /**
+    * \return Number of shards of this service.
+    */
+   int getShards() const noexcept { return shards.size(); }
+
+   /**
+    * \return Number of workers used to notify the observers.
+    */
+   int getWorkers() const noexcept { return workers.size(); }
+
+   /**
+    * \return Number of notifications delivered to the observers.
+    */
+   uint64_t getCallbackCounter() const noexcept { return callbacks.getCounter(); }
+
+   /**
+    * \return Accumulated time spent by the observers.
+    */
+   std::chrono::microseconds getCallbackDuration() const noexcept { return callbacks.getSum(); }
+
+   /**
+    * \return Longest time spent by one observer.
+    */
+   std::chrono::microseconds getMaxCallbackDuration() const noexcept { return callbacks.getMax(); }
+
+   /**
+    * \return Distribution of the time spent by the observers.
+    */
+   const Histogram& getCallbacks() const noexcept { return callbacks; }
+
+   /**
+    * \return Distribution of the delay between the expected expiration of the time events and their real expiration.
+    */
+   const Histogram& getLateness() const noexcept { return lateness; }
+
+   /**
+    * \return Distribution of the time spent processing every quantum, including the notifications done by the consumer.
+    */
+   const Histogram& getQuantumProcessing() const noexcept { return quantumProcessing; }
 
    /**
     * \return Summarize information of the instance
     */
    basis::StreamString asString() const noexcept;
 
+   /**
+    * \return Summarize information of the instance, with the histograms and the state of every shard.
+    */
+   std::shared_ptr<xml::Node> asXML(std::shared_ptr<xml::Node>& parent) const throw(basis::RuntimeException);
+
 private:
-   typedef std::list<std::shared_ptr<TimeEvent> > Quantum;
-   typedef Quantum::iterator quantum_iterator;
+   // Head of the events stored on a quantum
+   typedef TimeEvent* Quantum;
 
-   typedef std::pair<Quantum*, quantum_iterator> Location;
-   typedef std::unordered_map<TimeEvent::Id, Location> Events;
+   struct Shard;
+   typedef std::vector<std::unique_ptr<Shard> > Shards;
+
+   struct Worker;
+   typedef std::vector<std::unique_ptr<Worker> > Workers;
 
    const std::chrono::milliseconds maxTime;
    const std::chrono::milliseconds resolution;
    const int maxQuantum;
-   int currentQuantum;
-   Quantum* timeTable;
-   Events events;
-   Quantum temporaryQuantum;
-
-   std::mutex mutex;
-   std::condition_variable condition;
-   std::list<int> ticks;
-   std::thread consumer;
-   std::thread producer;
-
-   TimeService(app::Application& application, const std::chrono::milliseconds& maxTime, const std::chrono::milliseconds& resolution);
+   const int levels;
+   Shards shards;
+   Workers workers;
+   std::chrono::steady_clock::time_point startTime;
+   Histogram callbacks;
+   Histogram lateness;
+   Histogram quantumProcessing;
+   bool drivesCoarseClock;
+
+   TimeService(app::Application& application, const std::chrono::milliseconds& maxTime, const std::chrono::milliseconds& resolution, const int shards, const int workers);
    static int calculeMaxQuantum(const std::chrono::milliseconds& maxTime, const std::chrono::milliseconds& resolution) noexcept;
-   static void consume(TimeService& timeService) noexcept;
-   static void produce(TimeService& timeService) noexcept;
-
-   void timeout(std::unique_lock<std::mutex>& guard) throw(basis::RuntimeException);
-   void store(std::shared_ptr<TimeEvent> timeEvent, std::unique_lock<std::mutex>& guard) noexcept;
+   static int calculeLevels(const int maxQuantum) noexcept;
+   static void consume(TimeService& timeService, Shard& shard) noexcept;
+   static void work(TimeService& timeService, Worker& worker) noexcept;
+
+   Shard& getCurrentShard() noexcept;
+   void activate(Shard& shard, const std::shared_ptr<TimeEvent>& timeEvent) throw(basis::RuntimeException);
+   void tick(Shard& shard) noexcept;
+   void dispatch(Shard& shard, std::unique_lock<std::mutex>& guard) noexcept;
+   void deliver(const std::shared_ptr<TimeEvent>& timeEvent) noexcept;
+   void callback(basis::pattern::observer::Observer& observer, const TimeEvent& timeEvent) noexcept;
+   void cascade(Shard& shard) noexcept;
+   Quantum& findQuantum(Shard& shard, const uint64_t tick) noexcept;
+   void relocate(Shard& shard, TimeEvent* timeEvent) noexcept;
+   void clear(Shard& shard) noexcept;
+   static void link(Quantum& quantum, TimeEvent* timeEvent) noexcept;
+   static void unlink(TimeEvent* timeEvent) noexcept;
+   void store(Shard& shard, std::shared_ptr<TimeEvent> timeEvent, const uint64_t fromTick) noexcept;
 
    void do_initialize() throw(basis::RuntimeException) ;
    void do_stop() throw(basis::RuntimeException) ;
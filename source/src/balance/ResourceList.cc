@@ -25,6 +25,7 @@
 #include <coffee/balance/ResourceList.hpp>
 #include <coffee/balance/GuardResourceList.hpp>
 
+#include <chrono>
 #include <mutex>
 
 #include <coffee/basis/AsString.hpp>
@@ -39,6 +40,15 @@
 
 using namespace coffee;
 
+namespace {
+   // Resources marked as unavailable are checked again after this period
+   const int64_t RefreshPeriod = 1000;
+
+   int64_t currentTime() noexcept {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+}
+
 void balance::ResourceList::initialize()
    throw(basis::RuntimeException)
 {
@@ -58,6 +68,8 @@ void balance::ResourceList::initialize()
       }
    }
 
+   publish(guard);
+
    if(m_resources.empty())
       LOG_WARN(asString() << " does not have any resource");
 
@@ -88,6 +100,7 @@ bool balance::ResourceList::add(std::shared_ptr<Resource> resource)
 
       if(result == true) {
          m_resources.push_back(resource);
+         m_outdated.store(true, std::memory_order_release);
       }
    }
 
@@ -109,6 +122,24 @@ size_t balance::ResourceList::countAvailableResources(balance::GuardResourceList
    return result;
 }
 
+void balance::ResourceList::publish() const
+   noexcept
+{
+   GuardResourceList guard(m_mutex);
+
+   // Other thread could have published it while this one was waiting for the lock
+   if (m_outdated.load(std::memory_order_relaxed))
+      publish(guard);
+}
+
+void balance::ResourceList::publish(GuardResourceList&) const
+   noexcept
+{
+   m_snapshots.emplace_back(new Snapshot(m_resources));
+   m_snapshot.store(m_snapshots.back().get(), std::memory_order_release);
+   m_outdated.store(false, std::memory_order_release);
+}
+
 balance::ResourceList::resource_iterator balance::ResourceList::next(balance::GuardResourceList& guard, resource_iterator ii)
    noexcept
 {
@@ -147,3 +178,94 @@ std::shared_ptr<xml::Node> balance::ResourceList::asXML(std::shared_ptr<xml::Nod
 
    return result;
 }
+
+balance::ResourceList::Snapshot::Snapshot(const resource_container& resources) :
+   m_resources(resources),
+   m_wordCount((resources.size() + WordBits - 1) / WordBits),
+   m_words(new Word[m_wordCount]),
+   m_refreshTime(0)
+{
+   refresh();
+}
+
+int balance::ResourceList::Snapshot::select(const size_t from)
+   noexcept
+{
+   if (m_resources.empty())
+      return -1;
+
+   int64_t refreshTime = m_refreshTime.load(std::memory_order_relaxed);
+   const int64_t now = currentTime();
+
+   // Only one thread does the periodical check
+   if (now - refreshTime >= RefreshPeriod && m_refreshTime.compare_exchange_strong(refreshTime, now))
+      refresh();
+
+   for (int pass = 0; pass < 2; ++ pass) {
+      int index;
+
+      while ((index = findAvailable(from)) != -1) {
+         if (m_resources[index]->isAvailable())
+            return index;
+
+         m_words[index / WordBits].fetch_and(~(uint64_t(1) << (index % WordBits)), std::memory_order_relaxed);
+      }
+
+      // Some resource could have recovered since the last check
+      if (pass == 0)
+         refresh();
+   }
+
+   return -1;
+}
+
+int balance::ResourceList::Snapshot::findAvailable(const size_t from) const
+   noexcept
+{
+   const size_t firstWord = from / WordBits;
+   const int firstBit = from % WordBits;
+
+   // The first word is visited twice, the bits from the starting position at the beginning and the previous ones at the end
+   for (size_t ii = 0; ii <= m_wordCount; ++ ii) {
+      const size_t wordIndex = (firstWord + ii) % m_wordCount;
+      uint64_t word = m_words[wordIndex].load(std::memory_order_relaxed);
+
+      if (ii == 0)
+         word &= ~uint64_t(0) << firstBit;
+      else if (ii == m_wordCount)
+         word &= ~(~uint64_t(0) << firstBit);
+
+      if (word != 0)
+         return wordIndex * WordBits + __builtin_ctzll(word);
+   }
+
+   return -1;
+}
+
+size_t balance::ResourceList::Snapshot::countAvailable() const
+   noexcept
+{
+   size_t result = 0;
+
+   for (size_t ii = 0; ii < m_wordCount; ++ ii)
+      result += __builtin_popcountll(m_words[ii].load(std::memory_order_relaxed));
+
+   return result;
+}
+
+void balance::ResourceList::Snapshot::refresh()
+   noexcept
+{
+   for (size_t ii = 0; ii < m_wordCount; ++ ii) {
+      uint64_t word = 0;
+
+      for (size_t bit = 0, index = ii * WordBits; bit < WordBits && index < m_resources.size(); ++ bit, ++ index) {
+         if (m_resources[index]->isAvailable())
+            word |= uint64_t(1) << bit;
+      }
+
+      m_words[ii].store(word, std::memory_order_relaxed);
+   }
+
+   m_refreshTime.store(currentTime(), std::memory_order_relaxed);
+}
@@ -21,12 +21,9 @@
 // SOFTWARE.
 //
 
-#include <mutex>
-
 #include <coffee/balance/Resource.hpp>
 #include <coffee/balance/ResourceList.hpp>
 #include <coffee/balance/StrategyIndexed.hpp>
-#include <coffee/balance/GuardResourceList.hpp>
 
 #include <coffee/logger/Logger.hpp>
 #include <coffee/logger/TraceMethod.hpp>
@@ -39,28 +36,20 @@ std::shared_ptr<balance::Resource> balance::StrategyIndexed::apply(const Request
 {
    logger::TraceMethod tm (logger::Level::Local7, COFFEE_FILE_LOCATION);
 
-   GuardResourceList guard(m_resources);
+   ResourceList::Snapshot& snapshot = m_resources->getSnapshot();
 
-   if (m_resources->size(guard) == 0) {
+   if (snapshot.size() == 0) {
       COFFEE_THROW_NAMED_EXCEPTION(ResourceUnavailableException, m_resources->getName() << " is empty");
    }
 
    std::shared_ptr<Resource> result;
-   ResourceList::resource_iterator ww;
-   ResourceList::resource_iterator end;
 
    const int identifier = request.calculateIdentifier();
 
-   ww = end = m_resources->resource_begin(guard) + (identifier % m_resources->size(guard));
-
-   do {
-      std::shared_ptr<Resource>& w = ResourceList::resource(ww);
+   const int index = snapshot.select(identifier % snapshot.size());
 
-      if (w->isAvailable() == true) {
-         result = w;
-         break;
-      }
-   } while ((ww = m_resources->next(guard, ww)) != end);
+   if (index != -1)
+      result = snapshot.at(index);
 
    if (!result) {
       COFFEE_THROW_NAMED_EXCEPTION(ResourceUnavailableException, this->asString() << " there is not any available resource");
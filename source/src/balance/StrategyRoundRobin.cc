@@ -23,7 +23,6 @@
 
 #include <coffee/balance/Resource.hpp>
 #include <coffee/balance/StrategyRoundRobin.hpp>
-#include <coffee/balance/GuardResourceList.hpp>
 
 #include <coffee/logger/Logger.hpp>
 #include <coffee/logger/TraceMethod.hpp>
@@ -37,32 +36,24 @@ std::shared_ptr<balance::Resource> balance::StrategyRoundRobin::apply (const Req
 {
    logger::TraceMethod tm (logger::Level::Local7, COFFEE_FILE_LOCATION);
 
-    GuardResourceList guard(m_resources);
+   ResourceList::Snapshot& snapshot = m_resources->getSnapshot();
 
-    if (!m_position) {
-      m_position = m_resources->resource_begin(guard);
-   }
-
-   if (m_position.value() == m_resources->resource_end(guard)) {
+   if (snapshot.size() == 0) {
       COFFEE_THROW_NAMED_EXCEPTION(ResourceUnavailableException, m_resources->getName() << " is empty");
    }
 
    std::shared_ptr<Resource> result;
-   ResourceList::resource_iterator ww;
-   ResourceList::resource_iterator end;
-
-   ww = end = m_position.value();
+   size_t position = m_position.load(std::memory_order_relaxed);
+   int index;
 
+   // The next call to this method will start after the selected resource
    do {
-      std::shared_ptr<Resource>& w = ResourceList::resource(ww);
-
-      if (w->isAvailable () == true) {
-         // prepare the next call to this method
-         m_position = m_resources->next(guard, ww);
-         result = w;
+      if ((index = snapshot.select(position % snapshot.size())) == -1)
          break;
-      }
-   } while ((ww = m_resources->next(guard, ww)) != end);
+   } while (!m_position.compare_exchange_weak(position, index + 1, std::memory_order_relaxed));
+
+   if (index != -1)
+      result = snapshot.at(index);
 
    if (!result) {
       COFFEE_THROW_NAMED_EXCEPTION(ResourceUnavailableException, this->asString() << " there is not any available resource");
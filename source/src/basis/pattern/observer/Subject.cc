@@ -77,6 +77,12 @@ void observer::Subject::notify(const Event& event)
    }
 }
 
+void observer::Subject::notify(Observer& observer, const Event& event)
+   noexcept
+{
+   observer.update(*this, event);
+}
+
 //virtual
 coffee::basis::StreamString observer::Subject::asString() const
 noexcept
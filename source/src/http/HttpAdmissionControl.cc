@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include <coffee/http/HttpAdmissionControl.hpp>
+#include <coffee/xml/Attribute.hpp>
+#include <coffee/xml/Node.hpp>
+
+using namespace coffee;
+
+http::HttpAdmissionControl::HttpAdmissionControl(const int requestsPerSecond, const int burst, const int maxConcurrency)
+   throw(basis::RuntimeException) :
+   m_requestsPerSecond(requestsPerSecond),
+   m_burst(std::max(burst, 1)),
+   m_maxConcurrency(maxConcurrency),
+   m_tokens(std::max(burst, 1)),
+   m_lastRefill(Clock::now()),
+   m_inFlight(0),
+   m_acceptedCounter(0),
+   m_rateExceededCounter(0),
+   m_concurrencyExceededCounter(0)
+{
+   if (requestsPerSecond < 0 || maxConcurrency < 0) {
+      COFFEE_THROW_EXCEPTION("RequestsPerSecond=" << requestsPerSecond << " and MaxConcurrency=" << maxConcurrency << " can not be negative");
+   }
+}
+
+http::HttpAdmissionControl::Result::_v http::HttpAdmissionControl::acquire()
+   noexcept
+{
+   std::lock_guard<std::mutex> guard(m_mutex);
+
+   if (m_maxConcurrency != Unlimited && m_inFlight >= m_maxConcurrency) {
+      ++ m_concurrencyExceededCounter;
+      return Result::ConcurrencyExceeded;
+   }
+
+   if (m_requestsPerSecond != Unlimited) {
+      refill(Clock::now());
+
+      if (m_tokens < 1.0) {
+         ++ m_rateExceededCounter;
+         return Result::RateExceeded;
+      }
+
+      m_tokens -= 1.0;
+   }
+
+   ++ m_inFlight;
+   ++ m_acceptedCounter;
+   return Result::Accepted;
+}
+
+void http::HttpAdmissionControl::release()
+   noexcept
+{
+   std::lock_guard<std::mutex> guard(m_mutex);
+
+   if (m_inFlight > 0) {
+      -- m_inFlight;
+   }
+}
+
+std::chrono::seconds http::HttpAdmissionControl::getRetryAfter() const
+   noexcept
+{
+   std::lock_guard<std::mutex> guard(m_mutex);
+
+   // Concurrency rejections do not know when the running requests will finish, so the minimal value is used.
+   if (m_requestsPerSecond == Unlimited || m_tokens >= 1.0) {
+      return std::chrono::seconds(1);
+   }
+
+   const double waitSeconds = (1.0 - m_tokens) / m_requestsPerSecond;
+   return std::chrono::seconds(std::max(int64_t(1), (int64_t) std::ceil(waitSeconds)));
+}
+
+void http::HttpAdmissionControl::refill(const Clock::time_point& now)
+   noexcept
+{
+   const std::chrono::duration<double> elapsed = now - m_lastRefill;
+   m_lastRefill = now;
+   m_tokens = std::min(double(m_burst), m_tokens + elapsed.count() * m_requestsPerSecond);
+}
+
+basis::StreamString http::HttpAdmissionControl::asString() const
+   noexcept
+{
+   std::lock_guard<std::mutex> guard(m_mutex);
+
+   basis::StreamString result("http.HttpAdmissionControl {");
+   result << "RequestsPerSecond=" << m_requestsPerSecond;
+   result << " | Burst=" << m_burst;
+   result << " | MaxConcurrency=" << m_maxConcurrency;
+   result << " | InFlight=" << m_inFlight;
+   result << " | Accepted=" << m_acceptedCounter;
+   result << " | RateExceeded=" << m_rateExceededCounter;
+   result << " | ConcurrencyExceeded=" << m_concurrencyExceededCounter;
+   return result << "}";
+}
+
+std::shared_ptr<xml::Node> http::HttpAdmissionControl::asXML(std::shared_ptr<xml::Node>& parent) const
+   throw(basis::RuntimeException)
+{
+   std::lock_guard<std::mutex> guard(m_mutex);
+
+   std::shared_ptr<xml::Node> result = parent->createChild("http.AdmissionControl");
+
+   result->createAttribute("RequestsPerSecond", m_requestsPerSecond);
+   result->createAttribute("Burst", m_burst);
+   result->createAttribute("MaxConcurrency", m_maxConcurrency);
+
+   auto counters = result->createChild("Counters");
+   counters->createAttribute("InFlight", m_inFlight);
+   counters->createAttribute("Accepted", m_acceptedCounter);
+   counters->createAttribute("RateExceeded", m_rateExceededCounter);
+   counters->createAttribute("ConcurrencyExceeded", m_concurrencyExceededCounter);
+
+   return result;
+}
+
+//static
+const char* http::HttpAdmissionControl::Result::asString(const Result::_v value)
+   noexcept
+{
+   static const char* names[] = { "Accepted", "RateExceeded", "ConcurrencyExceeded" };
+   return names[value];
+}
@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <string.h>
+
+#include <coffee/basis/StreamString.hpp>
+
+#include <coffee/http/HttpByteRange.hpp>
+
+using namespace coffee;
+
+//static
+const char* http::HttpByteRange::Result::asString(const http::HttpByteRange::Result::_v value)
+   noexcept
+{
+   static const char* names[] = { "Ignored", "Satisfiable", "NotSatisfiable" };
+   return names[value];
+}
+
+//static
+http::HttpByteRange::Result::_v http::HttpByteRange::parse(const std::string& value, const uint64_t size, http::HttpByteRange& range)
+   noexcept
+{
+   static const char* unit = "bytes=";
+   static const size_t unitLength = strlen(unit);
+
+   const char* ii = value.c_str();
+   const char* end = ii + value.size();
+
+   while (ii < end && *ii == ' ')
+      ++ ii;
+
+   if (strncasecmp(ii, unit, unitLength) != 0)
+      return Result::Ignored;
+
+   ii += unitLength;
+
+   uint64_t first = 0;
+   uint64_t last = 0;
+   const bool hasFirst = readNumber(ii, end, first);
+
+   if (ii == end || *ii != '-')
+      return Result::Ignored;
+
+   ++ ii;
+
+   const bool hasLast = readNumber(ii, end, last);
+
+   while (ii < end && *ii == ' ')
+      ++ ii;
+
+   if (ii != end || (!hasFirst && !hasLast) || (hasFirst && hasLast && last < first))
+      return Result::Ignored;
+
+   if (!hasFirst) {
+      // Suffix range: the last N bytes
+      if (last == 0 || size == 0)
+         return Result::NotSatisfiable;
+
+      range.m_first = (last >= size) ? 0: size - last;
+      range.m_last = size - 1;
+      return Result::Satisfiable;
+   }
+
+   if (first >= size)
+      return Result::NotSatisfiable;
+
+   range.m_first = first;
+   range.m_last = (!hasLast || last >= size) ? size - 1: last;
+   return Result::Satisfiable;
+}
+
+std::string http::HttpByteRange::asContentRange(const uint64_t size) const
+   noexcept
+{
+   basis::StreamString result("bytes ");
+   return result << m_first << "-" << m_last << "/" << size;
+}
+
+//static
+bool http::HttpByteRange::readNumber(const char*& ii, const char* end, uint64_t& value)
+   noexcept
+{
+   const char* start = ii;
+
+   value = 0;
+   while (ii < end && *ii >= '0' && *ii <= '9' && (ii - start) < 19) {
+      value = value * 10 + (*ii - '0');
+      ++ ii;
+   }
+
+   return ii != start;
+}
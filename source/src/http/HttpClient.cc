@@ -31,7 +31,19 @@ using namespace coffee;
 std::shared_ptr<http::HttpResponse> http::HttpClient::send(const std::shared_ptr<http::HttpRequest>& request)
    throw(basis::RuntimeException)
 {
-   auto httpMessage = m_decoder.apply(m_clientSocket->send(m_encoder.apply(request)));
+   return decode(m_clientSocket->send(m_encoder.apply(request)));
+}
+
+std::shared_ptr<http::HttpResponse> http::HttpClient::send(const std::shared_ptr<http::HttpRequest>& request, const std::shared_ptr<time::Deadline>& deadline)
+   throw(basis::RuntimeException)
+{
+   return decode(m_clientSocket->send(m_encoder.apply(request), deadline));
+}
+
+std::shared_ptr<http::HttpResponse> http::HttpClient::decode(const basis::DataBlock& response)
+   throw(basis::RuntimeException)
+{
+   auto httpMessage = m_decoder.apply(response);
 
    auto httpResponse = std::dynamic_pointer_cast<http::HttpResponse>(httpMessage);
 
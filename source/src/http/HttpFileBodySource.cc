@@ -0,0 +1,92 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <coffee/basis/StreamString.hpp>
+
+#include <coffee/http/HttpFileBodySource.hpp>
+
+using namespace coffee;
+
+//static
+std::shared_ptr<http::HttpFileBodySource> http::HttpFileBodySource::instantiate(const std::string& path)
+   throw(basis::RuntimeException)
+{
+   std::shared_ptr<HttpFileBodySource> result(new HttpFileBodySource(path));
+
+   int fd = ::open(path.c_str(), O_RDONLY);
+
+   if (fd == -1) {
+      COFFEE_THROW_EXCEPTION("File " << path << " could not be opened");
+   }
+
+   struct stat data;
+
+   if (::fstat(fd, &data) == -1 || !S_ISREG(data.st_mode)) {
+      ::close(fd);
+      COFFEE_THROW_EXCEPTION("File " << path << " is not a regular file");
+   }
+
+   result->m_size = data.st_size;
+
+   if (result->m_size > 0) {
+      void* address = ::mmap(nullptr, result->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (address == MAP_FAILED) {
+         ::close(fd);
+         COFFEE_THROW_EXCEPTION("File " << path << " could not be mapped on memory");
+      }
+
+      result->m_data = (const char*) address;
+   }
+
+   ::close(fd);
+
+   // Same format used by most of the web servers: "<size>-<modification time>" in hexadecimal
+   char entityTag[64];
+   snprintf(entityTag, sizeof(entityTag), "\"%llx-%llx\"", (unsigned long long) result->m_size, (unsigned long long) data.st_mtime);
+   result->m_entityTag = entityTag;
+
+   return result;
+}
+
+http::HttpFileBodySource::~HttpFileBodySource()
+{
+   if (m_data != nullptr)
+      ::munmap((void*) m_data, m_size);
+}
+
+void http::HttpFileBodySource::copy(const uint64_t offset, const uint64_t length, basis::DataBlock& target) const
+   throw(basis::RuntimeException)
+{
+   if (offset > m_size || length > m_size - offset) {
+      COFFEE_THROW_EXCEPTION("Segment " << offset << "/" << length << " is out of file " << m_path);
+   }
+
+   target.assign(m_data + offset, length);
+}
@@ -80,6 +80,8 @@ HttpMessage& HttpMessage::setHeader(const HttpHeader::Type::_v type, const std::
       dd->second->get()->setValue(value);
    }
 
+   ++ m_headersVersion;
+
    return *this;
 }
 
@@ -97,6 +99,8 @@ HttpMessage& HttpMessage::setCustomHeader(const std::string& headerName, const s
       dd->second->get()->setValue(value);
    }
 
+   ++ m_headersVersion;
+
    return *this;
 }
 
@@ -0,0 +1,166 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <coffee/http/HttpParameters.hpp>
+#include <coffee/http/url/URL.hpp>
+
+using namespace coffee;
+
+namespace {
+
+const char* find(const char* begin, const char* end, const char cc)
+   noexcept
+{
+   auto result = (const char*) memchr(begin, cc, end - begin);
+   return (result == nullptr) ? end : result;
+}
+
+}
+
+void http::HttpParameters::parse(const char* data, const size_t size)
+   noexcept
+{
+   m_data = data;
+   m_decoded.clear();
+   m_size = 0;
+
+   const char* end = data + size;
+
+   // The table will never be filled over the half of its capacity
+   size_t capacity = 8;
+   for (size_t pairs = std::count(data, end, '&') + 1; capacity < pairs * 2;)
+      capacity <<= 1;
+
+   m_slots.assign(capacity, Slot());
+
+   const size_t mask = capacity - 1;
+
+   for (const char* ii = data; ii < end;) {
+      const char* endPair = find(ii, end, '&');
+      const char* separator = find(ii, endPair, '=');
+
+      if (separator != ii) {
+         Slot slot;
+         slot.used = true;
+         slot.key = makeReference(ii, separator);
+         slot.value = makeReference(std::min(separator + 1, endPair), endPair);
+         slot.hash = calculateHash(address(slot.key), slot.key.size);
+
+         for (size_t index = slot.hash & mask;; index = (index + 1) & mask) {
+            Slot& current = m_slots[index];
+
+            if (!current.used) {
+               current = slot;
+               ++ m_size;
+               break;
+            }
+
+            if (current.hash == slot.hash && current.key.size == slot.key.size && memcmp(address(current.key), address(slot.key), slot.key.size) == 0)
+               break;
+         }
+      }
+
+      ii = endPair + 1;
+   }
+}
+
+std::string http::HttpParameters::getValue(const std::string& name) const
+   throw(basis::RuntimeException)
+{
+   auto slot = lookup(name);
+
+   if (slot == nullptr) {
+      COFFEE_THROW_EXCEPTION("Parameter " << name << " was not found");
+   }
+
+   return asString(slot->value);
+}
+
+std::string http::HttpParameters::getValue(const std::string& name, const std::string& defaultValue) const
+   noexcept
+{
+   auto slot = lookup(name);
+   return (slot == nullptr) ? defaultValue: asString(slot->value);
+}
+
+const http::HttpParameters::Slot* http::HttpParameters::lookup(const std::string& name) const
+   noexcept
+{
+   if (m_size == 0)
+      return nullptr;
+
+   const uint32_t hash = calculateHash(name.data(), name.size());
+   const size_t mask = m_slots.size() - 1;
+
+   for (size_t index = hash & mask;; index = (index + 1) & mask) {
+      const Slot& slot = m_slots[index];
+
+      if (!slot.used)
+         return nullptr;
+
+      if (slot.hash == hash && slot.key.size == name.size() && memcmp(address(slot.key), name.data(), name.size()) == 0)
+         return &slot;
+   }
+}
+
+http::HttpParameters::Reference http::HttpParameters::makeReference(const char* begin, const char* end)
+   noexcept
+{
+   Reference result;
+   const size_t size = end - begin;
+
+   const bool isEncoded = find(begin, end, '%') != end || find(begin, end, '+') != end;
+
+   if (!isEncoded || !url::URL::isEncodingValid(begin, size)) {
+      result.offset = begin - m_data;
+      result.size = size;
+      result.decoded = false;
+   }
+   else {
+      result.offset = m_decoded.size();
+      url::URL::decode(begin, size, m_decoded);
+      result.size = m_decoded.size() - result.offset;
+      result.decoded = true;
+   }
+
+   return result;
+}
+
+// FNV-1a
+//static
+uint32_t http::HttpParameters::calculateHash(const char* data, const size_t size)
+   noexcept
+{
+   uint32_t result = 2166136261u;
+
+   for (size_t ii = 0; ii < size; ++ ii) {
+      result ^= (unsigned char) data[ii];
+      result *= 16777619u;
+   }
+
+   return result;
+}
@@ -21,6 +21,8 @@
 // SOFTWARE.
 //
 
+#include <string.h>
+
 #include <coffee/http/HttpRequest.hpp>
 #include <coffee/http/protocol/defines.hpp>
 #include <coffee/http/url/URLParser.hpp>
@@ -37,6 +39,59 @@ std::shared_ptr<http::HttpRequest> http::HttpRequest::instantiate(const http::Ht
    return result;
 }
 
+const http::HttpParameters& http::HttpRequest::getQueryParameters() const
+   noexcept
+{
+   if (!m_queryParsed) {
+      auto query = m_url->getEncodedQuery();
+      m_queryParameters.parse(query.first, query.second);
+      m_queryParsed = true;
+   }
+
+   return m_queryParameters;
+}
+
+const http::HttpParameters& http::HttpRequest::getFormParameters() const
+   noexcept
+{
+   static const char* formContentType = "application/x-www-form-urlencoded";
+
+   // The Content-Type decides whether the body is parsed, so both of them invalidate the parameters
+   if (m_formParsed && m_formBodyVersion == getBodyVersion() && m_formHeadersVersion == getHeadersVersion()) {
+      return m_formParameters;
+   }
+
+   m_formParsed = true;
+   m_formBodyVersion = getBodyVersion();
+   m_formHeadersVersion = getHeadersVersion();
+
+   bool isForm = false;
+
+   if (hasHeader(HttpHeader::Type::ContentType)) {
+      const std::string& contentType = getHeaderValue(HttpHeader::Type::ContentType);
+      const auto start = contentType.find_first_not_of(' ');
+      isForm = start != std::string::npos && strncasecmp(contentType.c_str() + start, formContentType, strlen(formContentType)) == 0;
+   }
+
+   const basis::DataBlock& body = getBody();
+
+   if (isForm)
+      m_formParameters.parse(body.data(), body.size());
+   else
+      m_formParameters.parse(nullptr, 0);
+
+   return m_formParameters;
+}
+
+std::string http::HttpRequest::getParameter(const std::string& name) const
+   throw(basis::RuntimeException)
+{
+   if (getQueryParameters().hasParameter(name))
+      return m_queryParameters.getValue(name);
+
+   return getFormParameters().getValue(name);
+}
+
 std::string http::HttpRequest::encodeFirstLine() const
    throw(basis::RuntimeException)
 {
@@ -23,6 +23,10 @@
 
 #include <map>
 
+#include <coffee/basis/AsString.hpp>
+
+#include <coffee/http/HttpBodySource.hpp>
+#include <coffee/http/HttpByteRange.hpp>
 #include <coffee/http/HttpResponse.hpp>
 #include <coffee/http/HttpRequest.hpp>
 
@@ -43,6 +47,59 @@ http::HttpResponse::HttpResponse(const uint16_t majorVersion, const uint16_t min
 {
 }
 
+//static
+std::shared_ptr<http::HttpResponse> http::HttpResponse::instantiate(const std::shared_ptr<HttpRequest>& request, const HttpBodySource& source)
+   throw(basis::RuntimeException)
+{
+   auto result = instantiate(request);
+
+   const uint64_t size = source.getSize();
+   const std::string entityTag = source.getEntityTag();
+
+   result->setHeader(HttpHeader::Type::AcceptRanges, "bytes");
+
+   if (!entityTag.empty())
+      result->setHeader(HttpHeader::Type::ETAG, entityTag);
+
+   HttpByteRange range;
+   HttpByteRange::Result::_v rangeResult = HttpByteRange::Result::Ignored;
+
+   if (request->hasHeader(HttpHeader::Type::Range)) {
+      bool isValid = true;
+
+      // If-Range only accepts strong entity tags, any other validator will cause to send the complete content
+      if (request->hasHeader(HttpHeader::Type::IfRange)) {
+         const std::string& ifRange = request->getHeaderValue(HttpHeader::Type::IfRange);
+         const auto start = ifRange.find_first_not_of(' ');
+         isValid = !entityTag.empty() && start != std::string::npos && ifRange.compare(start, std::string::npos, entityTag) == 0;
+      }
+
+      if (isValid)
+         rangeResult = HttpByteRange::parse(request->getHeaderValue(HttpHeader::Type::Range), size, range);
+   }
+
+   basis::DataBlock body;
+
+   switch (rangeResult) {
+   case HttpByteRange::Result::Satisfiable:
+      result->setStatusCode(206);
+      result->setHeader(HttpHeader::Type::ContentRange, range.asContentRange(size));
+      source.copy(range.getFirst(), range.getLength(), body);
+      break;
+   case HttpByteRange::Result::NotSatisfiable:
+      result->setStatusCode(416);
+      result->setHeader(HttpHeader::Type::ContentRange, "bytes */" + basis::AsString::apply(size));
+      break;
+   case HttpByteRange::Result::Ignored:
+      source.copy(0, size, body);
+      break;
+   }
+
+   result->setBody(body);
+
+   return result;
+}
+
 std::string http::HttpResponse::encodeFirstLine() const
    throw(basis::RuntimeException)
 {
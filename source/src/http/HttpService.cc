@@ -22,6 +22,7 @@
 //
 
 #include <coffee/app/Application.hpp>
+#include <coffee/http/HttpAdmissionControl.hpp>
 #include <coffee/http/HttpClient.hpp>
 #include <coffee/http/HttpRequest.hpp>
 #include <coffee/http/HttpResponse.hpp>
@@ -31,6 +32,7 @@
 #include <coffee/http/protocol/HttpProtocolEncoder.hpp>
 #include <coffee/http/SCCS.hpp>
 #include <coffee/logger/Logger.hpp>
+#include <coffee/logger/Throttle.hpp>
 #include <coffee/networking/AsyncSocket.hpp>
 #include <coffee/networking/NetworkingService.hpp>
 #include <coffee/networking/SocketArguments.hpp>
@@ -60,6 +62,16 @@ private:
       throw(basis::RuntimeException);
 };
 
+// Releases the admitted request once the servlet has finished, even if it throws an exception.
+class GuardAdmissionControl {
+public:
+   explicit GuardAdmissionControl(std::shared_ptr<HttpAdmissionControl>& admissionControl) : m_admissionControl(admissionControl) {;}
+   ~GuardAdmissionControl() { if (m_admissionControl) m_admissionControl->release(); }
+
+private:
+   std::shared_ptr<HttpAdmissionControl>& m_admissionControl;
+};
+
 }
 }
 
@@ -120,6 +132,30 @@ std::shared_ptr<http::HttpServlet> http::HttpService::findServlet(const std::str
    return ii->second;
 }
 
+void http::HttpService::setAdmissionControl(const std::string& path, std::shared_ptr<HttpAdmissionControl> admissionControl)
+   throw(basis::RuntimeException)
+{
+   if (!admissionControl) {
+      COFFEE_THROW_EXCEPTION("Admission control for path " << path << " can not be empty");
+   }
+
+   if (m_servlets.find(path) == m_servlets.end()) {
+      COFFEE_THROW_EXCEPTION("There is not Servlet defined for path " << path);
+   }
+
+   m_admissionControls[path] = admissionControl;
+}
+
+std::shared_ptr<http::HttpAdmissionControl> http::HttpService::findAdmissionControl(const std::string& path) const
+   noexcept
+{
+   static std::shared_ptr<http::HttpAdmissionControl> empty;
+
+   auto ii = m_admissionControls.find(path);
+
+   return (ii == m_admissionControls.end()) ? empty: ii->second;
+}
+
 std::shared_ptr<xml::Node> http::HttpService::asXML(std::shared_ptr<xml::Node>& parent) const
    throw(basis::RuntimeException)
 {
@@ -132,6 +168,11 @@ std::shared_ptr<xml::Node> http::HttpService::asXML(std::shared_ptr<xml::Node>&
       auto xmlServlet = xmlServlets->createChild("Servlet");
       xmlServlet->createAttribute("Path", servlet.first);
       xmlServlet->createAttribute("Operation", typeid(*(servlet.second.get())).name());
+
+      auto admissionControl = findAdmissionControl(servlet.first);
+      if (admissionControl) {
+         admissionControl->asXML(xmlServlet);
+      }
    }
 
    return result;
@@ -178,19 +219,37 @@ void http::HttpRequestHandler::apply(const basis::DataBlock& dataBlock, networki
       return;
    }
 
+   std::string path;
    std::shared_ptr<HttpServlet> servlet;
 
    try {
-      servlet = m_httpService.findServlet(httpRequest->getPath());
+      path = httpRequest->getPath();
+      servlet = m_httpService.findServlet(path);
    }
    catch(basis::RuntimeException& ex) {
       basis::StreamString ss;
-      ss << httpRequest->getPath() << " was not service for any servlet";
-      LOG_ERROR(ss);
+      ss << path << " was not service for any servlet";
+      LOG_ERROR_RATE(10, ss);
       serverSocket.send(encoder.apply(http::HttpResponse::instantiate(1, 1, 404, ss)));
       return;
    }
 
+   auto admissionControl = m_httpService.findAdmissionControl(path);
+
+   if (admissionControl) {
+      auto admission = admissionControl->acquire();
+
+      if (admission != HttpAdmissionControl::Result::Accepted) {
+         LOG_WARN_RATE(10, path << " rejected | Result=" << HttpAdmissionControl::Result::asString(admission));
+         auto response = http::HttpResponse::instantiate(1, 1, 503, "");
+         response->setHeader(HttpHeader::Type::RetryAfter, basis::AsString::apply(admissionControl->getRetryAfter().count()));
+         serverSocket.send(encoder.apply(response));
+         return;
+      }
+   }
+
+   GuardAdmissionControl guard(admissionControl);
+
    try {
       serverSocket.send(encoder.apply(servlet->service(httpRequest)));
    }
@@ -21,95 +21,138 @@
 // SOFTWARE.
 //
 
+#include <string.h>
+
+#include <algorithm>
+
 #include <coffee/http/url/URLBuilder.hpp>
 #include <coffee/http/url/URLParser.hpp>
 #include <coffee/http/url/URL.hpp>
 
 using namespace coffee;
 
-http::url::URL::URL(const URLBuilder& builder) :
-   m_components(builder.m_components),
-   m_query(builder.m_keyValues)
+namespace {
+
+int hexValue(const unsigned char cc)
+   noexcept
 {
+   if (cc >= '0' && cc <= '9')
+      return cc - '0';
+
+   if (cc >= 'a' && cc <= 'f')
+      return cc - 'a' + 10;
+
+   if (cc >= 'A' && cc <= 'F')
+      return cc - 'A' + 10;
+
+   return -1;
 }
 
-http::url::URL::URL(const URLParser& builder) :
-   m_components(builder.m_components),
-   m_query(builder.m_keyValues)
+const char* find(const char* begin, const char* end, const char cc)
+   noexcept
 {
+   auto result = (const char*) memchr(begin, cc, end - begin);
+   return (result == nullptr) ? end : result;
+}
+
 }
 
-const std::string& http::url::URL::getComponent(const ComponentName::_v component) const
+http::url::URL::URL(const std::string& buffer, const Segments& segments, const Segment& query) :
+   m_buffer(buffer),
+   m_query(query)
+{
+   std::copy(segments, segments + ComponentName::Fragment + 1, m_segments);
+}
+
+std::string http::url::URL::getComponent(const ComponentName::_v component) const
    throw(basis::RuntimeException)
 {
-   auto ii = m_components.find(component);
+   const Segment& segment = m_segments[component];
 
-   if (ii == m_components.end()) {
+   if (segment.size == 0) {
       COFFEE_THROW_EXCEPTION("URL does not contain component " << ComponentName::asString(component));
    }
 
-   return ii->second;
+   return std::string(m_buffer.data() + segment.offset, segment.size);
 }
 
-std::string http::url::URL::encode() const
-   throw(basis::RuntimeException)
+const http::url::Query& http::url::URL::getKeyValues() const
+   noexcept
 {
-   basis::StreamString ss;
+   std::call_once(m_keyValuesDecoded, [this]() {
+      const char* ii = m_buffer.data() + m_query.offset;
+      const char* end = ii + m_query.size;
 
-   if (hasComponent(ComponentName::Scheme)) {
-      ss << getComponent(ComponentName::Scheme) << "://";
-   }
+      while (ii < end) {
+         const char* endPair = find(ii, end, '&');
 
-   bool hasUserInformation = false;
+         if (endPair != ii) {
+            const char* separator = find(ii, endPair, '=');
 
-   if (hasComponent(ComponentName::User)) {
-      ss << getComponent(ComponentName::User);
-      hasUserInformation = true;
-   }
+            KeyValue keyValue;
+            decode(ii, separator - ii, keyValue.first);
 
-   if (hasComponent(ComponentName::Password)) {
-      ss << ":" << getComponent(ComponentName::Password);
-      hasUserInformation = true;
-   }
+            if (separator != endPair) {
+               ++ separator;
+               decode(separator, endPair - separator, keyValue.second);
+            }
 
-   if (hasUserInformation) {
-      ss << "@";
-   }
+            m_keyValues.push_back(std::move(keyValue));
+         }
 
-   if (hasComponent(ComponentName::Host)) {
-      ss << getComponent(ComponentName::Host);
-   }
+         ii = endPair + 1;
+      }
+   });
 
-   if (hasComponent(ComponentName::Port)) {
-      ss << ":" << getComponent(ComponentName::Port);
-   }
+   return m_keyValues;
+}
 
-   if (hasComponent(ComponentName::Path)) {
-      ss << getComponent(ComponentName::Path);
-   }
+// Runs of characters that do not need to be decoded are located by memchr, which is vectorized by the libc,
+// and they are appended as a whole.
+//static
+void http::url::URL::decode(const char* data, const size_t size, std::string& result)
+   noexcept
+{
+   const char* ii = data;
+   const char* end = data + size;
+   const char* nextPercent = find(ii, end, '%');
+   const char* nextPlus = find(ii, end, '+');
 
-   if (!m_query.empty()) {
-      bool isFirst = true;
-      for (auto& pair : m_query) {
-         if (isFirst) {
-            ss << "?";
-            isFirst = false;
-         }
-         else {
-            ss << "&";
-         }
-         ss << pair.first;
+   result.reserve(result.size() + size);
 
-         if (!pair.second.empty()) {
-            ss << "=" << pair.second;
-         }
+   while (ii < end) {
+      const char* next = std::min(nextPercent, nextPlus);
+
+      result.append(ii, next - ii);
+
+      if (next == end)
+         break;
+
+      if (next == nextPlus) {
+         result.push_back(' ');
+         ii = next + 1;
+         nextPlus = find(ii, end, '+');
+      }
+      else {
+         result.push_back((char) ((hexValue(next[1]) << 4) | hexValue(next[2])));
+         ii = next + 3;
+         nextPercent = find(ii, end, '%');
+         if (nextPlus < ii)
+            nextPlus = find(ii, end, '+');
       }
    }
+}
+
+//static
+bool http::url::URL::isEncodingValid(const char* data, const size_t size)
+   noexcept
+{
+   const char* end = data + size;
 
-   if (hasComponent(ComponentName::Fragment)) {
-      ss << getComponent(ComponentName::Fragment);
+   for (const char* ii = find(data, end, '%'); ii != end; ii = find(ii + 3, end, '%')) {
+      if (end - ii < 3 || hexValue(ii[1]) == -1 || hexValue(ii[2]) == -1)
+         return false;
    }
 
-   return ss;
+   return true;
 }
-
@@ -21,6 +21,10 @@
 // SOFTWARE.
 //
 
+#include <string.h>
+
+#include <cctype>
+
 #include <coffee/http/url/URLBuilder.hpp>
 #include <coffee/http/url/URL.hpp>
 
@@ -49,6 +53,88 @@ std::shared_ptr<http::url::URL> http::url::URLBuilder::build() const
       COFFEE_THROW_EXCEPTION("URLBuilder should contain the Host");
    }
 
-   std::shared_ptr<http::url::URL> result(new URL(*this));
+   std::string buffer;
+   URL::Segments segments;
+   URL::Segment query;
+
+   append(buffer, segments, ComponentName::Scheme, nullptr, "://");
+
+   bool hasUserInformation = append(buffer, segments, ComponentName::User, nullptr, nullptr);
+   hasUserInformation |= append(buffer, segments, ComponentName::Password, ":", nullptr);
+
+   if (hasUserInformation) {
+      buffer += '@';
+   }
+
+   append(buffer, segments, ComponentName::Host, nullptr, nullptr);
+   append(buffer, segments, ComponentName::Port, ":", nullptr);
+   append(buffer, segments, ComponentName::Path, nullptr, nullptr);
+
+   if (!m_keyValues.empty()) {
+      buffer += '?';
+      query.offset = buffer.size();
+
+      bool isFirst = true;
+      for (auto& pair : m_keyValues) {
+         if (!isFirst) {
+            buffer += '&';
+         }
+         isFirst = false;
+
+         encode(pair.first, buffer);
+
+         if (!pair.second.empty()) {
+            buffer += '=';
+            encode(pair.second, buffer);
+         }
+      }
+
+      query.size = buffer.size() - query.offset;
+   }
+
+   append(buffer, segments, ComponentName::Fragment, nullptr, nullptr);
+
+   std::shared_ptr<http::url::URL> result(new URL(buffer, segments, query));
    return result;
 }
+
+bool http::url::URLBuilder::append(std::string& buffer, URL::Segments& segments, const ComponentName::_v component, const char* prefix, const char* suffix) const
+   noexcept
+{
+   auto ii = m_components.find(component);
+
+   if (ii == m_components.end() || ii->second.empty()) {
+      return false;
+   }
+
+   if (prefix != nullptr) {
+      buffer += prefix;
+   }
+
+   segments[component] = URL::Segment(buffer.size(), ii->second.size());
+   buffer += ii->second;
+
+   if (suffix != nullptr) {
+      buffer += suffix;
+   }
+
+   return true;
+}
+
+//static
+void http::url::URLBuilder::encode(const std::string& value, std::string& buffer)
+   noexcept
+{
+   static const char* hexDigits = "0123456789ABCDEF";
+
+   for (unsigned char cc : value) {
+      if (isalnum(cc) || strchr("-._~/:@!$'()*,;", cc) != nullptr) {
+         buffer += (char) cc;
+      }
+      else {
+         buffer += '%';
+         buffer += hexDigits[cc >> 4];
+         buffer += hexDigits[cc & 0x0f];
+      }
+   }
+}
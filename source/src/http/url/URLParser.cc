@@ -21,12 +21,15 @@
 // SOFTWARE.
 //
 
+#include <string.h>
+
+#include <algorithm>
+#include <cctype>
+
 #include <coffee/http/url/URLParser.hpp>
 #include <coffee/http/url/URL.hpp>
 #include <coffee/http/url/ComponentName.hpp>
 
-#include <coffee/http/protocol/defines.hpp>
-
 using namespace coffee;
 
 // Analize searching for  scheme:[//[user[:password]@]host[:port]][/path][?query][#fragment]
@@ -46,168 +49,152 @@ using namespace coffee;
 std::shared_ptr<http::url::URL> http::url::URLParser::build()
    throw(basis::RuntimeException)
 {
-   if (m_url[0] == '/') {
-      auto endPath = readPath(m_url, 0);
-      auto endQuery = readQuery(m_url, endPath);
-      readFragment(m_url, endQuery);
+   std::fill(m_segments, m_segments + ComponentName::Fragment + 1, URL::Segment());
+   m_query = URL::Segment();
+
+   size_type endScheme = 0;
+   size_type endAuthority = 0;
+
+   if (m_url[0] != '/') {
+      endScheme = find(':', 0, m_url.size());
+
+      if (endScheme == m_url.size()) {
+         COFFEE_THROW_EXCEPTION(m_url << " does not contain any " << http::url::ComponentName::asString(ComponentName::Host));
+      }
+
+      addMandatoryComponent(ComponentName::Scheme, 0, endScheme);
+      endAuthority = readAuthority(endScheme + 1);
    }
-   else {
-      auto separation = protocol::separate(m_url, ':');
-      const std::string& scheme = separation.first;
-      addMandatoryComponent(ComponentName::Scheme, scheme);
-
-      const std::string& withoutScheme = separation.second;
-      auto endAuthority = readAuthority(withoutScheme);
-      auto endPath = readPath(withoutScheme, endAuthority);
-      auto endQuery = readQuery(withoutScheme, endPath);
-      readFragment(withoutScheme, endQuery);
+
+   auto endPath = readPath(endAuthority);
+   auto endQuery = readQuery(endPath);
+   readFragment(endQuery);
+
+   if (endScheme == 0 || m_url.compare(endScheme + 1, 2, "//") == 0) {
+      std::shared_ptr<http::url::URL> result(new URL(m_url, m_segments, m_query));
+      return result;
    }
 
-   std::shared_ptr<http::url::URL> result(new URL(*this));
+   // scheme:host is kept as scheme://host, so the URL will always be encoded in the same way
+   std::string buffer(m_url);
+   buffer.insert(endScheme + 1, "//");
+
+   for (auto& segment : m_segments) {
+      if (segment.offset > endScheme)
+         segment.offset += 2;
+   }
+   m_query.offset += 2;
+
+   std::shared_ptr<http::url::URL> result(new URL(buffer, m_segments, m_query));
    return result;
 }
 
-std::string::size_type http::url::URLParser::readAuthority(const std::string& withoutScheme)
+http::url::URLParser::size_type http::url::URLParser::readAuthority(const size_type begin)
    throw(basis::RuntimeException)
 {
-   auto start = withoutScheme.find("//");
-
-   if (start != std::string::npos) {
-      start += 2;
-   }
-   else {
-      start = 0;
+   auto start = (m_url.compare(begin, 2, "//") == 0) ? begin + 2: begin;
+   auto end = findFirstOf("/?#", start);
+   auto endUserInformation = find('@', start, end);
+   auto endPoint = start;
+
+   if (endUserInformation != end) {
+      auto endUser = find(':', start, endUserInformation);
+      addOptionalComponent(ComponentName::User, start, endUser);
+      if (endUser != endUserInformation)
+         addOptionalComponent(ComponentName::Password, endUser + 1, endUserInformation);
+      endPoint = endUserInformation + 1;
    }
 
-   auto token = extractToken(withoutScheme, start, "/?#");
+   auto endHost = find(':', endPoint, end);
+   addMandatoryComponent(ComponentName::Host, endPoint, endHost);
 
-   if (token.first.find('@', start) == std::string::npos) {
-      auto separation = protocol::separate(token.first, ':');
-      addMandatoryComponent(ComponentName::Host, separation.first);
-      addOptionalComponent(ComponentName::Port, verifyPortIsNumeric(separation.second));
-   }
-   else {
-      auto separation = protocol::separate(token.first, '@');
-      const std::string& userInformation = separation.first;
-      const std::string& endPoint = separation.second;
-
-      {
-         auto separation = protocol::separate(userInformation, ':');
-         addOptionalComponent(ComponentName::User, separation.first);
-         addOptionalComponent(ComponentName::Password, separation.second);
-      }
-      {
-         auto separation = protocol::separate(endPoint, ':');
-         addMandatoryComponent(ComponentName::Host, separation.first);
-         addOptionalComponent(ComponentName::Port, verifyPortIsNumeric(separation.second));
-      }
+   if (endHost != end) {
+      addOptionalComponent(ComponentName::Port, endHost + 1, end);
+      verifyPortIsNumeric();
    }
 
-   return token.second;
+   return end;
 }
 
-std::string::size_type http::url::URLParser::readPath(const std::string& withoutScheme, const std::string::size_type endPrevious)
+http::url::URLParser::size_type http::url::URLParser::readPath(const size_type begin)
    noexcept
 {
-   if (endPrevious == withoutScheme.size()) {
-      return endPrevious;
-   }
-
-   auto token = extractToken(withoutScheme, endPrevious, "?#");
-   addOptionalComponent(ComponentName::Path, token.first);
-   return token.second;
+   auto end = findFirstOf("?#", begin);
+   addOptionalComponent(ComponentName::Path, begin, end);
+   return end;
 }
 
-std::string::size_type http::url::URLParser::readQuery(const std::string& withoutScheme, const std::string::size_type endPrevious)
+// The query is only validated here, URL will split it and decode the pairs on demand.
+http::url::URLParser::size_type http::url::URLParser::readQuery(const size_type begin)
    throw(basis::RuntimeException)
 {
-   if (endPrevious == withoutScheme.size()) {
-      return endPrevious;
+   if (begin == m_url.size() || m_url[begin] != '?') {
+      return begin;
    }
 
-   if (withoutScheme[endPrevious] != '?') {
-      return endPrevious;
-   }
+   const auto start = begin + 1;
+   const auto end = find('#', start, m_url.size());
 
-   auto token = extractToken(withoutScheme, endPrevious + 1, "#");
-
-   std::vector<std::string> pairs = protocol::split(token.first, '&');
-
-   for (auto& pair : pairs) {
-      auto keyValue = protocol::separate(pair, '=');
-
-      if (keyValue.first.empty()) {
-         COFFEE_THROW_EXCEPTION(token.first << " contains an empty key");
+   for (auto ii = start; ii < end; ++ ii) {
+      if (m_url[ii] == '=' && (ii == start || m_url[ii - 1] == '&')) {
+         COFFEE_THROW_EXCEPTION(m_url.substr(start, end - start) << " contains an empty key");
       }
+   }
 
-      m_keyValues.push_back(keyValue);
+   if (!URL::isEncodingValid(m_url.data() + start, end - start)) {
+      COFFEE_THROW_EXCEPTION(m_url.substr(start, end - start) << " contains an invalid percent-encoding");
    }
 
-   return token.second;
+   m_query = URL::Segment(start, end - start);
+
+   return end;
 }
 
-void http::url::URLParser::readFragment(const std::string& withoutScheme, const std::string::size_type endPrevious)
+void http::url::URLParser::readFragment(const size_type begin)
    noexcept
 {
-   if (endPrevious == withoutScheme.size()) {
-      return;
-   }
-
-   addOptionalComponent(ComponentName::Fragment, withoutScheme.substr(endPrevious));
+   addOptionalComponent(ComponentName::Fragment, begin, m_url.size());
 }
 
-void http::url::URLParser::addMandatoryComponent(const http::url::ComponentName::_v componentName, const std::string& value)
+void http::url::URLParser::addMandatoryComponent(const http::url::ComponentName::_v componentName, const size_type begin, const size_type end)
    throw(basis::RuntimeException)
 {
-   if (value.empty()) {
+   if (begin == end) {
       COFFEE_THROW_EXCEPTION(m_url << " does not contain any " << http::url::ComponentName::asString(componentName));
    }
-   m_components[componentName] = value;
+   m_segments[componentName] = URL::Segment(begin, end - begin);
 }
 
-void http::url::URLParser::addOptionalComponent(const http::url::ComponentName::_v componentName, const std::string& value)
+void http::url::URLParser::addOptionalComponent(const http::url::ComponentName::_v componentName, const size_type begin, const size_type end)
    noexcept
 {
-   if (!value.empty())
-      m_components[componentName] = value;
+   if (begin < end)
+      m_segments[componentName] = URL::Segment(begin, end - begin);
 }
 
-//static
-http::url::URLParser::Token http::url::URLParser::extractToken(const std::string& withoutScheme, const std::string::size_type initpos, const char* finalDelims)
-   noexcept
+void http::url::URLParser::verifyPortIsNumeric() const
+   throw(basis::RuntimeException)
 {
-   std::string::size_type end = 0;
-
-    do {
-      end = withoutScheme.find(*finalDelims ++, initpos);
-      if (end != std::string::npos)
-         break;
-   } while (*finalDelims);
+   const URL::Segment& port = m_segments[ComponentName::Port];
 
-   Token result;
+   const char* ii = m_url.data() + port.offset;
+   const char* end = ii + port.size;
 
-   if (end == std::string::npos) {
-      result.first = withoutScheme.substr(initpos);
-      result.second = withoutScheme.size();
+   if (std::find_if_not(ii, end, [](unsigned char cc) { return std::isdigit(cc); }) != end) {
+      COFFEE_THROW_EXCEPTION("Port " << m_url.substr(port.offset, port.size) << " should be a numeric value");
    }
-   else {
-      result.first.assign(withoutScheme.begin() + initpos, withoutScheme.begin() + end);
-      result.second = end;
-   }
-
-   return result;
 }
 
-//static
-const std::string& http::url::URLParser::verifyPortIsNumeric(const std::string& value)
-   throw(basis::RuntimeException)
+http::url::URLParser::size_type http::url::URLParser::find(const char delim, const size_type begin, const size_type end) const
+   noexcept
 {
-   if (value.empty())
-      return value;
-
-   if (!protocol::isNumeric(value)) {
-      COFFEE_THROW_EXCEPTION("Port " << value << " should be a numeric value");
-   }
+   auto result = (const char*) memchr(m_url.data() + begin, delim, end - begin);
+   return (result == nullptr) ? end : result - m_url.data();
+}
 
-   return value;
+http::url::URLParser::size_type http::url::URLParser::findFirstOf(const char* delims, const size_type begin) const
+   noexcept
+{
+   auto result = m_url.find_first_of(delims, begin);
+   return (result == std::string::npos) ? m_url.size() : result;
 }
@@ -0,0 +1,254 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <algorithm>
+#include <chrono>
+
+#include <coffee/logger/AsyncWriter.hpp>
+#include <coffee/logger/Logger.hpp>
+
+using namespace coffee;
+
+// Bounded multi-producer queue as described by Dmitry Vyukov: every slot keeps a sequence number which tells
+// whether it is waiting for a producer (sequence == position) or for the consumer (sequence == position + 1).
+
+//static
+const int logger::AsyncWriter::MinimalCapacity;
+//static
+const int logger::AsyncWriter::MaxBatchSize;
+
+//static
+const char* logger::AsyncWriter::OverflowPolicy::asString(const OverflowPolicy::_v value)
+   noexcept
+{
+   static const char* names[] = { "Block", "Drop" };
+   return names[value];
+}
+
+logger::AsyncWriter::AsyncWriter(std::shared_ptr<Writer> target, const size_t capacity, const OverflowPolicy::_v overflowPolicy) :
+   Writer("AsyncWriter"),
+   m_target(target),
+   m_overflowPolicy(overflowPolicy),
+   m_slots(calculateCapacity(capacity)),
+   m_mask(m_slots.size() - 1),
+   m_enqueuePosition(0),
+   m_dequeuePosition(0),
+   m_droppedCounter(0),
+   m_writtenCounter(0),
+   m_stop(false),
+   m_sleeping(false),
+   m_blockedProducers(0)
+{
+   for (size_t ii = 0; ii < m_slots.size(); ++ ii) {
+      m_slots[ii].sequence.store(ii, std::memory_order_relaxed);
+   }
+}
+
+logger::AsyncWriter::~AsyncWriter()
+{
+   stop();
+}
+
+void logger::AsyncWriter::initialize()
+   throw(basis::RuntimeException)
+{
+   stop();
+
+   m_target->initialize();
+
+   m_stop = false;
+   m_consumer = std::thread(&AsyncWriter::run, this);
+}
+
+void logger::AsyncWriter::apply(const Level::_v level, const std::string& line)
+   noexcept
+{
+   push(level, line, false);
+}
+
+bool logger::AsyncWriter::applyRecord(const Level::_v level, const Record& record)
+   noexcept
+{
+   push(level, record.getData(), true);
+   return true;
+}
+
+void logger::AsyncWriter::push(const Level::_v level, const std::string& data, const bool record)
+   noexcept
+{
+   if (tryPush(level, data, record))
+      return;
+
+   if (m_overflowPolicy == OverflowPolicy::Drop || !m_consumer.joinable()) {
+      m_droppedCounter.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+
+   ++ m_blockedProducers;
+   while (!tryPush(level, data, record)) {
+      wakeUpConsumer();
+      std::unique_lock<std::mutex> guard(m_mutex);
+      m_notFull.wait_for(guard, std::chrono::milliseconds(1));
+   }
+   -- m_blockedProducers;
+}
+
+void logger::AsyncWriter::flush()
+   noexcept
+{
+   const size_t target = m_enqueuePosition.load();
+
+   while (m_consumer.joinable() && m_dequeuePosition.load() < target) {
+      wakeUpConsumer();
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+   }
+}
+
+bool logger::AsyncWriter::tryPush(const Level::_v level, const std::string& data, const bool record)
+   noexcept
+{
+   size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+   Slot* slot;
+
+   for (;;) {
+      slot = &m_slots[position & m_mask];
+      const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+
+      if (difference == 0) {
+         if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+      }
+      else if (difference < 0) {
+         return false;
+      }
+      else {
+         position = m_enqueuePosition.load(std::memory_order_relaxed);
+      }
+   }
+
+   slot->line.first = level;
+   slot->line.second.assign(data);
+   slot->record = record;
+   slot->sequence.store(position + 1, std::memory_order_release);
+
+   // Pairs with the fence in #run, so either the consumer sees this line or this thread sees it sleeping
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (m_sleeping.load(std::memory_order_relaxed))
+      wakeUpConsumer();
+
+   return true;
+}
+
+// Only called from the consumer thread. The strings are swapped so their buffers are reused by the ring,
+// the binary records are formatted here.
+size_t logger::AsyncWriter::pop(std::vector<Line>& batch)
+   noexcept
+{
+   size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+   size_t result = 0;
+
+   while (result < batch.size()) {
+      Slot& slot = m_slots[position & m_mask];
+
+      if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+         break;
+
+      batch[result].first = slot.line.first;
+      if (slot.record)
+         Logger::format(slot.line.second, batch[result].second);
+      else
+         batch[result].second.swap(slot.line.second);
+      slot.sequence.store(position + m_mask + 1, std::memory_order_release);
+
+      ++ position;
+      ++ result;
+   }
+
+   return result;
+}
+
+void logger::AsyncWriter::wakeUpConsumer()
+   noexcept
+{
+   std::lock_guard<std::mutex> guard(m_mutex);
+   m_notEmpty.notify_one();
+}
+
+void logger::AsyncWriter::stop()
+   noexcept
+{
+   if (!m_consumer.joinable())
+      return;
+
+   m_stop = true;
+   wakeUpConsumer();
+   m_consumer.join();
+}
+
+void logger::AsyncWriter::run()
+   noexcept
+{
+   std::vector<Line> batch(MaxBatchSize);
+
+   for (;;) {
+      const size_t size = pop(batch);
+
+      if (size > 0) {
+         m_target->applyBatch(batch.data(), size);
+         m_writtenCounter.fetch_add(size, std::memory_order_relaxed);
+         m_dequeuePosition.fetch_add(size, std::memory_order_release);
+
+         if (m_blockedProducers.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_notFull.notify_all();
+         }
+         continue;
+      }
+
+      if (m_stop)
+         break;
+
+      std::unique_lock<std::mutex> guard(m_mutex);
+      m_sleeping.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      const size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+      if (m_slots[position & m_mask].sequence.load(std::memory_order_acquire) != position + 1 && !m_stop)
+         m_notEmpty.wait_for(guard, std::chrono::milliseconds(100));
+
+      m_sleeping.store(false, std::memory_order_relaxed);
+   }
+}
+
+//static
+size_t logger::AsyncWriter::calculateCapacity(const size_t capacity)
+   noexcept
+{
+   size_t result = MinimalCapacity;
+
+   while (result < capacity)
+      result <<= 1;
+
+   return result;
+}
@@ -22,6 +22,10 @@
 //
 
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
 #include <coffee/logger/Logger.hpp>
 #include <coffee/logger/BacktraceWriter.hpp>
 
@@ -30,10 +34,91 @@ using namespace coffee;
 //static
 const int logger::BacktraceWriter::MaxBacktrackingLength = 4096;
 
+namespace {
+   std::atomic<unsigned> writerIds(0);
+
+   struct Entry {
+      int64_t timestamp;
+      logger::Level::_v level;
+      std::string line;
+   };
+}
+
+// Only its thread writes on it, the mutex is only contended while a backtrace is being written.
+struct logger::BacktraceWriter::History {
+   std::mutex mutex;
+   std::vector<Entry> entries;
+   size_t next;
+   size_t size;
+   std::atomic<bool> owned;
+
+   explicit History(const size_t capacity) : entries(capacity), next(0), size(0), owned(true) {;}
+
+   void push(const Level::_v level, const std::string& line) noexcept {
+      const int64_t timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+
+      std::lock_guard<std::mutex> guard(mutex);
+      Entry& entry = entries[next];
+      entry.timestamp = timestamp;
+      entry.level = level;
+      entry.line.assign(line);
+
+      next = (next + 1) % entries.size();
+      if (size < entries.size())
+         ++ size;
+   }
+};
+
+// Every thread keeps the rings of the last writers it has used, so a thread tracing on some writers
+// does not release and acquire a ring on every line. The rings are released when the thread finishes,
+// so other thread could reuse them.
+struct logger::BacktraceWriter::ThreadHistory {
+   static const int MaxWriters = 4;
+
+   struct Slot {
+      unsigned writerId;
+      std::shared_ptr<History> history;
+
+      Slot() : writerId(0) {;}
+
+      void release() noexcept {
+         if (history)
+            history->owned = false;
+         history.reset();
+         writerId = 0;
+      }
+   };
+
+   Slot slots[MaxWriters];
+   int next;
+
+   ThreadHistory() : next(0) {;}
+   ~ThreadHistory() {
+      for (auto& slot : slots)
+         slot.release();
+   }
+
+   Slot* find(const unsigned writerId) noexcept {
+      for (auto& slot : slots) {
+         if (slot.writerId == writerId)
+            return &slot;
+      }
+      return nullptr;
+   }
+
+   // The slots are replaced in round robin
+   Slot& replace() noexcept {
+      Slot& result = slots[next];
+      next = (next + 1) % MaxWriters;
+      result.release();
+      return result;
+   }
+};
+
 logger::BacktraceWriter::BacktraceWriter (const std::string& path, const size_t maxSize, const int backtrackingLength) :
   CircularTraceWriter(path, maxSize),
   m_backtrackingLength (std::min (backtrackingLength, MaxBacktrackingLength)),
-  m_lineCounter (0),
+  m_id (++ writerIds),
   m_lowestLevel (Level::Debug)
 {
 }
@@ -45,34 +130,65 @@ void logger::BacktraceWriter::apply (const Level::_v level, const std::string& l
       backtrace ();
       CircularTraceWriter::apply(level, line);
    }
-   else if (level > Level::Error && level <= m_lowestLevel) {
-      Line storedLine (level, line);
+   else if (level <= m_lowestLevel && m_backtrackingLength > 0) {
+      getHistory().push(level, line);
+   }
+}
 
-      if (m_lineCounter == m_backtrackingLength) {
-         m_lines.pop_front();
-         m_lines.push_back(storedLine);
-      }
-      else {
-         m_lines.push_back(storedLine);
-         m_lineCounter ++;
+logger::BacktraceWriter::History& logger::BacktraceWriter::getHistory()
+   noexcept
+{
+   static thread_local ThreadHistory cache;
+
+   if (ThreadHistory::Slot* slot = cache.find(m_id))
+      return *slot->history;
+
+   ThreadHistory::Slot& slot = cache.replace();
+
+   std::lock_guard<std::mutex> guard(m_mutex);
+
+   for (auto& history : m_histories) {
+      bool owned = false;
+      if (history->owned.compare_exchange_strong(owned, true)) {
+         slot.history = history;
+         break;
       }
    }
+
+   if (!slot.history) {
+      slot.history = std::make_shared<History>(m_backtrackingLength);
+      m_histories.push_back(slot.history);
+   }
+
+   slot.writerId = m_id;
+   return *slot.history;
 }
 
 void logger::BacktraceWriter::backtrace()
    noexcept
 {
-   Level::_v originalLevel = Logger::getLevel();
+   std::vector<Entry> entries;
 
-   Logger::setLevel (m_lowestLevel);
+   {
+      std::lock_guard<std::mutex> guard(m_mutex);
 
-   for (auto ii = m_lines.begin (), maxii = m_lines.end (); ii != maxii; ++ ii) {
-      auto storedLine = *ii;
-      CircularTraceWriter::apply(storedLine.first, storedLine.second);
+      for (auto& history : m_histories) {
+         std::lock_guard<std::mutex> historyGuard(history->mutex);
+         const size_t capacity = history->entries.size();
+
+         for (size_t ii = 0; ii < history->size; ++ ii) {
+            entries.push_back(history->entries[(history->next + capacity - history->size + ii) % capacity]);
+         }
+
+         history->size = 0;
+      }
    }
 
-   m_lines.clear();
-   m_lineCounter = 0;
+   std::stable_sort(entries.begin(), entries.end(), [](const Entry& left, const Entry& right) { return left.timestamp < right.timestamp; });
 
-   Logger::setLevel(originalLevel);
+   const size_t first = (entries.size() > size_t(m_backtrackingLength)) ? entries.size() - m_backtrackingLength: 0;
+
+   for (size_t ii = first; ii < entries.size(); ++ ii) {
+      CircularTraceWriter::apply(entries[ii].level, entries[ii].line);
+   }
 }
@@ -54,12 +54,8 @@ void logger::CircularTraceWriter::initialize() throw(basis::RuntimeException)
 {
    openStream();
 
-   if (oversizedStream() == true) {
-      closeStream();
-      renameFile();
-      openStream();
-      m_loops ++;
-   }
+   if (oversizedStream() == true)
+      rotate();
 }
 
 void logger::CircularTraceWriter::apply(const Level::_v level, const std::string& line)
@@ -73,19 +69,41 @@ void logger::CircularTraceWriter::apply(const Level::_v level, const std::string
       return;
    }
 
-   try {
-      write(m_stream, line.data(), line.length());
-      write(m_stream, "\n", 1);
+   if (writeLine(m_stream, line) == false)
+      std::cerr << "Can not write on file: " << m_path << ". Error: " << strerror(errno) << std::endl;
 
-      if ((++ m_lineno % CheckSizePeriod) != 0)
-         return;
+   if ((++ m_lineno % CheckSizePeriod) == 0)
+      rotateIfOversized();
+}
 
-      if (oversizedStream() == true) {
-         closeStream();
-         renameFile();
-         openStream();
-         m_loops ++;
-      }
+void logger::CircularTraceWriter::applyBatch(const Line* lines, const size_t size)
+   noexcept
+{
+   if (m_stream == NullStream) {
+      Writer::applyBatch(lines, size);
+      return;
+   }
+
+   for (size_t first = 0; first < size; first += MaxBatchLines) {
+      const size_t count = std::min(size - first, size_t(MaxBatchLines));
+
+      if (writeLines(m_stream, lines + first, count) == false)
+         std::cerr << "Can not write on file: " << m_path << ". Error: " << strerror(errno) << std::endl;
+
+      const size_t previous = m_lineno;
+      m_lineno += count;
+
+      if ((previous / CheckSizePeriod) != (m_lineno / CheckSizePeriod))
+         rotateIfOversized();
+   }
+}
+
+void logger::CircularTraceWriter::rotateIfOversized()
+   noexcept
+{
+   try {
+      if (oversizedStream() == true)
+         rotate();
    }
    catch(basis::RuntimeException& ex) {
       std::cerr << ex.what() << std::endl;
@@ -99,17 +117,40 @@ bool logger::CircularTraceWriter::wantsToProcess(const logger::Level::_v level)
    return(m_stream != NullStream) ? logger::Writer::wantsToProcess(level): level <= Level::Error;
 }
 
+void logger::CircularTraceWriter::rotate()
+   throw(basis::RuntimeException)
+{
+   renameFile();
+
+   // The new file replaces the renamed one without going through the closed state, so the
+   // mask of levels is not narrowed to the errors while rotating
+   const int stream = createStream();
+   ::close(m_stream);
+   m_stream = stream;
+   m_loops ++;
+
+   levelsChanged();
+}
+
 void coffee::logger::CircularTraceWriter::openStream()
    throw(basis::RuntimeException)
+{
+   m_stream = createStream();
+
+   levelsChanged();
+}
+
+int coffee::logger::CircularTraceWriter::createStream()
+   throw(basis::RuntimeException)
 {
    int stream = open(m_path.c_str(), O_RDWR | O_CREAT | O_APPEND, S_IRUSR |S_IWUSR | S_IRGRP| S_IROTH);
 
    if (stream == -1)
       COFFEE_THROW_EXCEPTION("Can not open file: " << m_path << ". Error: " << strerror(errno));
 
-   m_stream = stream;
-
    fcntl(stream, F_SETFL, fcntl(stream, F_GETFL) | O_NONBLOCK);
+
+   return stream;
 }
 
 bool coffee::logger::CircularTraceWriter::oversizedStream()
@@ -135,6 +176,8 @@ void logger::CircularTraceWriter::closeStream()
       ::close(m_stream);
 
    m_stream = NullStream;
+
+   levelsChanged();
 }
 
 void logger::CircularTraceWriter::renameFile()
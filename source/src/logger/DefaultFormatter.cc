@@ -23,32 +23,110 @@
 #include <chrono>
 
 #include <coffee/logger/DefaultFormatter.hpp>
+#include <coffee/logger/Fields.hpp>
 
 #include <coffee/basis/StreamString.hpp>
 #include <coffee/basis/AsString.hpp>
 #include <coffee/basis/AsHexString.hpp>
 
+#include <coffee/time/CoarseClock.hpp>
+
 using namespace coffee;
 using namespace coffee::logger;
 
+namespace {
+
+struct DateCache {
+   int64_t second;
+   std::string date;
+
+   DateCache() : second(-1) {;}
+};
+
+// localtime and strftime are only called when the second changes for the calling thread
+const std::string& getDate(const std::chrono::seconds& second) noexcept {
+   static thread_local DateCache cache;
+
+   if (cache.second != second.count()) {
+      cache.second = second.count();
+      try {
+         cache.date = basis::AsString::apply(second, "%d/%0m/%Y %T");
+      }
+      catch(const basis::Exception&) {
+         cache.date.clear();
+      }
+   }
+
+   return cache.date;
+}
+
+void appendFraction(basis::StreamString& output, unsigned value, const int digits) noexcept {
+   char buffer[8];
+
+   buffer[0] = '.';
+   for (int ii = digits; ii > 0; -- ii) {
+      buffer[ii] = '0' + (value % 10);
+      value /= 10;
+   }
+
+   output.append(buffer, digits + 1);
+}
+
+}
+
+//static
+const char* DefaultFormatter::Precision::asString(const Precision::_v value)
+   noexcept
+{
+   static const char* names[] = { "Seconds", "Milliseconds", "Microseconds" };
+   return names[value];
+}
+
 std::string DefaultFormatter::apply (const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno)
    noexcept
+{
+   // Without fraction of second a few milliseconds of error are not visible, so it avoids reading the clock
+   if (m_precision == Precision::Seconds)
+      return apply(level, comment, methodName, file, lineno, time::CoarseClock::now(), pthread_self());
+
+   return apply(level, comment, methodName, file, lineno, std::chrono::system_clock::now(), pthread_self());
+}
+
+std::string DefaultFormatter::apply (const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno,
+   const std::chrono::system_clock::time_point& timestamp, const pthread_t thread)
+   noexcept
 {
    // See https://stackoverflow.com/questions/9089842/c-chrono-system-time-in-milliseconds-time-operations
-   auto second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch());
+   auto second = std::chrono::duration_cast<std::chrono::seconds>(timestamp.time_since_epoch());
 
    basis::StreamString output;
 
-   try {
-      output << "[" << basis::AsString::apply(second, "%d/%0m/%Y %T") << "] ";
-   }
-   catch(const basis::Exception&) {
+   const std::string& date = getDate(second);
+
+   if (!date.empty()) {
+      output << "[" << date;
+
+      const auto fraction = timestamp.time_since_epoch() - second;
+
+      if (m_precision == Precision::Milliseconds)
+         appendFraction(output, std::chrono::duration_cast<std::chrono::milliseconds>(fraction).count(), 3);
+      else if (m_precision == Precision::Microseconds)
+         appendFraction(output, std::chrono::duration_cast<std::chrono::microseconds>(fraction).count(), 6);
+
+      output << "] ";
    }
 
-   output << "[thr=" << basis::AsHexString::apply((int64_t) pthread_self()) << "] ";
+   output << "[thr=" << basis::AsHexString::apply((int64_t) thread) << "] ";
    output << Level::enumName(level) << " | ";
    output << methodName << " [" << file << "(" << lineno << ")]: ";
    output << comment;
 
+   const Fields* fields = Fields::getCurrent();
+
+   if (fields != nullptr && !fields->empty()) {
+      output << " | ";
+      fields->appendText(output);
+   }
+
    return output;
 }
@@ -0,0 +1,84 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <stdio.h>
+
+#include <coffee/logger/Fields.hpp>
+
+using namespace coffee;
+
+//static
+const int logger::Fields::MaxSize;
+
+namespace {
+   thread_local const logger::Fields* current = nullptr;
+}
+
+//static
+const logger::Fields* logger::Fields::getCurrent()
+   noexcept
+{
+   return current;
+}
+
+//static
+const logger::Fields* logger::Fields::setCurrent(const Fields* fields)
+   noexcept
+{
+   const Fields* result = current;
+   current = fields;
+   return result;
+}
+
+void logger::Fields::appendText(std::string& output) const
+   noexcept
+{
+   char buffer[32];
+   bool first = true;
+
+   for (const Field& field : *this) {
+      if (!first)
+         output += ' ';
+      first = false;
+
+      output.append(field.name).append(1, '=');
+
+      switch (field.type) {
+      case Type::Signed:
+         output.append(buffer, snprintf(buffer, sizeof(buffer), "%lld", (long long) field.integer));
+         break;
+      case Type::Unsigned:
+         output.append(buffer, snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long) field.unsignedInteger));
+         break;
+      case Type::Real:
+         output.append(buffer, snprintf(buffer, sizeof(buffer), "%.15g", field.real));
+         break;
+      case Type::Boolean:
+         output.append(field.boolean ? "true": "false");
+         break;
+      case Type::Text:
+         output.append(field.text, field.length);
+         break;
+      }
+   }
+}
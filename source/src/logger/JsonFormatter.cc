@@ -0,0 +1,219 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <cmath>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <coffee/basis/StreamString.hpp>
+
+#include <coffee/logger/JsonFormatter.hpp>
+#include <coffee/logger/Fields.hpp>
+
+using namespace coffee;
+using namespace coffee::logger;
+
+//static
+const int JsonFormatter::InitialBufferSize;
+
+namespace {
+
+struct Buffer {
+   std::string output;
+   int64_t second;
+   char date[32];
+   size_t dateLength;
+
+   Buffer() : second(-1), dateLength(0) { output.reserve(JsonFormatter::InitialBufferSize); }
+};
+
+Buffer& getBuffer() noexcept {
+   static thread_local Buffer buffer;
+   return buffer;
+}
+
+void appendString(std::string& output, const char* data, const size_t size) noexcept {
+   static const char hex[] = "0123456789abcdef";
+
+   output += '"';
+
+   const char* first = data;
+   const char* end = data + size;
+
+   for (const char* ii = data; ii != end; ++ ii) {
+      const unsigned char cc = *ii;
+
+      if (cc >= 0x20 && cc != '"' && cc != '\\')
+         continue;
+
+      output.append(first, ii - first);
+      first = ii + 1;
+
+      switch (cc) {
+      case '"': output.append("\\\""); break;
+      case '\\': output.append("\\\\"); break;
+      case '\n': output.append("\\n"); break;
+      case '\r': output.append("\\r"); break;
+      case '\t': output.append("\\t"); break;
+      default:
+         output.append("\\u00");
+         output += hex[cc >> 4];
+         output += hex[cc & 0xf];
+      }
+   }
+
+   output.append(first, end - first);
+   output += '"';
+}
+
+void appendString(std::string& output, const char* value) noexcept {
+   appendString(output, value, strlen(value));
+}
+
+void appendKey(std::string& output, const char* key) noexcept {
+   appendString(output, key);
+   output += ':';
+}
+
+void appendValue(std::string& output, const Fields::Field& field) noexcept {
+   char buffer[32];
+
+   switch (field.type) {
+   case Fields::Type::Signed:
+      output.append(buffer, snprintf(buffer, sizeof(buffer), "%lld", (long long) field.integer));
+      break;
+   case Fields::Type::Unsigned:
+      output.append(buffer, snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long) field.unsignedInteger));
+      break;
+   case Fields::Type::Real:
+      if (std::isfinite(field.real))
+         output.append(buffer, snprintf(buffer, sizeof(buffer), "%.15g", field.real));
+      else
+         output.append("null");
+      break;
+   case Fields::Type::Boolean:
+      output.append(field.boolean ? "true": "false");
+      break;
+   case Fields::Type::Text:
+      appendString(output, field.text, field.length);
+      break;
+   }
+}
+
+// gmtime_r and strftime are only called when the second changes for the calling thread
+void appendTimestamp(std::string& output, Buffer& buffer, const std::chrono::system_clock::time_point& timestamp) noexcept {
+   const auto sinceEpoch = timestamp.time_since_epoch();
+   const auto second = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+
+   if (buffer.second != second.count()) {
+      const time_t time = second.count();
+      struct tm tt;
+
+      buffer.second = second.count();
+      buffer.dateLength = (gmtime_r(&time, &tt) == nullptr) ? 0: strftime(buffer.date, sizeof(buffer.date), "%Y-%m-%dT%H:%M:%S", &tt);
+   }
+
+   const unsigned milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch - second).count();
+   const char fraction[] = { '.', char('0' + milliseconds / 100), char('0' + (milliseconds / 10) % 10), char('0' + milliseconds % 10), 'Z', '"' };
+
+   output += '"';
+   output.append(buffer.date, buffer.dateLength);
+   output.append(fraction, sizeof(fraction));
+}
+
+void appendTrace(std::string& output, const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno,
+   const std::chrono::system_clock::time_point& timestamp, const pthread_t thread)
+   noexcept
+{
+   char aux[32];
+
+   output.append("{\"timestamp\":");
+   appendTimestamp(output, getBuffer(), timestamp);
+
+   output.append(",\"level\":");
+   appendString(output, Level::enumName(level));
+
+   output.append(",\"thread\":\"");
+   output.append(aux, snprintf(aux, sizeof(aux), "0x%jx", (uintmax_t) thread));
+
+   output.append("\",\"function\":");
+   appendString(output, methodName);
+
+   output.append(",\"file\":");
+   appendString(output, file);
+
+   output.append(",\"line\":");
+   output.append(aux, snprintf(aux, sizeof(aux), "%u", lineno));
+
+   output.append(",\"message\":");
+   appendString(output, comment.data(), comment.size());
+
+   const Fields* fields = Fields::getCurrent();
+
+   if (fields != nullptr && !fields->empty()) {
+      output.append(",\"fields\":{");
+
+      bool first = true;
+      for (const Fields::Field& field : *fields) {
+         if (!first)
+            output += ',';
+         first = false;
+
+         appendKey(output, field.name);
+         appendValue(output, field);
+      }
+
+      output += '}';
+   }
+
+   output += '}';
+}
+
+}
+
+std::string JsonFormatter::apply (const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno)
+   noexcept
+{
+   return apply(level, comment, methodName, file, lineno, std::chrono::system_clock::now(), pthread_self());
+}
+
+std::string JsonFormatter::apply (const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno,
+   const std::chrono::system_clock::time_point& timestamp, const pthread_t thread)
+   noexcept
+{
+   std::string result;
+   result.reserve(InitialBufferSize);
+   appendTrace(result, level, comment, methodName, file, lineno, timestamp, thread);
+   return result;
+}
+
+const std::string& JsonFormatter::format (const Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno, std::string&)
+   noexcept
+{
+   std::string& output = getBuffer().output;
+   output.clear();
+   appendTrace(output, level, comment, methodName, file, lineno, std::chrono::system_clock::now(), pthread_self());
+   return output;
+}
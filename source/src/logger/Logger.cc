@@ -21,9 +21,13 @@
 // SOFTWARE.
 //
 
+#include <mutex>
+#include <thread>
+
 #include <coffee/logger/Logger.hpp>
 
 #include <coffee/logger/Writer.hpp>
+#include <coffee/logger/Fields.hpp>
 #include <coffee/logger/DefaultFormatter.hpp>
 #include <coffee/logger/Level.hpp>
 #include <coffee/logger/SCCS.hpp>
@@ -31,14 +35,123 @@
 
 using namespace coffee;
 
+struct logger::Logger::Snapshot {
+   Writers writers;
+   std::shared_ptr<Formatter> formatter;
+};
+
 #ifdef _DEBUG
-   logger::Level::_v logger::Logger::m_level = Level::Debug;
+   std::atomic<logger::Level::_v> logger::Logger::m_level(Level::Debug);
 #else
-   logger::Level::_v logger::Logger::m_level = Level::Warning;
+   std::atomic<logger::Level::_v> logger::Logger::m_level(Level::Warning);
 #endif
 
-std::shared_ptr<logger::Formatter> logger::Logger::m_formatter;
-logger::Logger::Writers logger::Logger::m_writers;
+std::atomic<const logger::Logger::Snapshot*> logger::Logger::m_snapshot(nullptr);
+std::atomic<unsigned> logger::Logger::m_levelMask(0);
+
+namespace {
+
+/**
+ * Every thread which reads the snapshot owns one of these slots. The counter is odd while the
+ * thread is inside a read section, and only its owner writes it, so entering a section is a
+ * plain store and a fence instead of a shared read-modify-write.
+ */
+struct ReaderSlot {
+   std::atomic<unsigned long> counter;
+   unsigned depth;
+
+   ReaderSlot() : counter(0), depth(0) {;}
+};
+
+struct Readers {
+   std::mutex mutex;
+   std::vector<ReaderSlot*> slots;
+};
+
+// Never released so threads which finish after the static destructors can still unregister.
+Readers& getReaders() noexcept {
+   static Readers* readers = new Readers;
+   return *readers;
+}
+
+class ThreadReader {
+public:
+   ThreadReader() {
+      Readers& readers = getReaders();
+      std::lock_guard<std::mutex> guard(readers.mutex);
+      readers.slots.push_back(&m_slot);
+   }
+
+   ~ThreadReader() {
+      Readers& readers = getReaders();
+      std::lock_guard<std::mutex> guard(readers.mutex);
+      for (auto ii = readers.slots.begin(), maxii = readers.slots.end(); ii != maxii; ++ ii) {
+         if (*ii == &m_slot) {
+            readers.slots.erase(ii);
+            break;
+         }
+      }
+   }
+
+   ReaderSlot& getSlot() noexcept { return m_slot; }
+
+private:
+   ReaderSlot m_slot;
+};
+
+ReaderSlot& getReaderSlot() noexcept {
+   static thread_local ThreadReader reader;
+   return reader.getSlot();
+}
+
+class ReadSection {
+public:
+   ReadSection() noexcept : m_slot(getReaderSlot()) {
+      if (m_slot.depth ++ == 0) {
+         m_slot.counter.store(m_slot.counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+         // Pairs with the fence in waitForReaders: either the updater sees this thread as a reader or
+         // this thread sees the new snapshot.
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+   }
+
+   ~ReadSection() {
+      if (-- m_slot.depth == 0) {
+         m_slot.counter.store(m_slot.counter.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+      }
+   }
+
+   bool isNested() const noexcept { return m_slot.depth > 1; }
+
+   ReadSection(const ReadSection&) = delete;
+   ReadSection& operator=(const ReadSection&) = delete;
+
+private:
+   ReaderSlot& m_slot;
+};
+
+void waitForReaders() noexcept {
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+
+   Readers& readers = getReaders();
+   std::lock_guard<std::mutex> guard(readers.mutex);
+
+   for (ReaderSlot* slot : readers.slots) {
+      const unsigned long counter = slot->counter.load(std::memory_order_acquire);
+
+      if ((counter & 1) == 0)
+         continue;
+
+      while (slot->counter.load(std::memory_order_acquire) == counter) {
+         std::this_thread::yield();
+      }
+   }
+}
+
+std::mutex updateMutex;
+std::mutex levelMaskMutex;
+
+}
 
 //static
 void logger::Logger::initialize(std::shared_ptr<Writer> writer, std::shared_ptr<Formatter> formatter)
@@ -46,11 +159,22 @@ void logger::Logger::initialize(std::shared_ptr<Writer> writer, std::shared_ptr<
 {
    SCCS::activate();
 
-   m_writers.clear();
-   m_writers.push_back(writer);
-   m_formatter = formatter;
+   std::lock_guard<std::mutex> guard(updateMutex);
 
-   writer->initialize();
+   std::unique_ptr<Snapshot> snapshot(new Snapshot);
+   snapshot->writers.push_back(writer);
+   snapshot->formatter = formatter;
+
+   try {
+      writer->initialize();
+   }
+   catch (basis::RuntimeException&) {
+      // The writer is kept even if it could not be initialized, it will decide how to handle the traces.
+      publish(snapshot.release());
+      throw;
+   }
+
+   publish(snapshot.release());
 }
 
 //static
@@ -64,12 +188,72 @@ void logger::Logger::initialize(std::shared_ptr<Writer> writer)
 void logger::Logger::add(std::shared_ptr<Writer> writer)
    throw (basis::RuntimeException)
 {
-   if (!m_formatter) {
+   std::lock_guard<std::mutex> guard(updateMutex);
+
+   const Snapshot* current = m_snapshot.load(std::memory_order_acquire);
+
+   if (current == nullptr || !current->formatter) {
       COFFEE_THROW_EXCEPTION("You should initialize the Logger before add a new writer");
    }
 
    writer->initialize();
-   m_writers.push_back(writer);
+
+   std::unique_ptr<Snapshot> snapshot(new Snapshot(*current));
+   snapshot->writers.push_back(writer);
+   publish(snapshot.release());
+}
+
+//static
+void logger::Logger::publish(const Snapshot* snapshot)
+   throw(basis::RuntimeException)
+{
+   if (getReaderSlot().depth != 0) {
+      delete snapshot;
+      COFFEE_THROW_EXCEPTION("The Logger can not be reconfigured while it is writing a trace");
+   }
+
+   const Snapshot* previous = m_snapshot.exchange(snapshot, std::memory_order_seq_cst);
+
+   refreshLevelMask();
+
+   if (previous != nullptr) {
+      waitForReaders();
+      delete previous;
+   }
+}
+
+//static
+void logger::Logger::setLevel(const Level::_v level)
+   noexcept
+{
+   m_level.store(level, std::memory_order_relaxed);
+   refreshLevelMask();
+}
+
+//static
+void logger::Logger::refreshLevelMask()
+   noexcept
+{
+   // The snapshot is read under the mutex, so the last one to store the mask has seen the newest snapshot
+   std::lock_guard<std::mutex> guard(levelMaskMutex);
+
+   ReadSection section;
+   const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+
+   unsigned mask = 0;
+
+   if (snapshot != nullptr && snapshot->formatter) {
+      for (int level = Level::Emergency; level <= Level::Local7; ++ level) {
+         for (const auto& writer : snapshot->writers) {
+            if (writer->wantsToProcess((Level::_v) level)) {
+               mask |= 1u << (level + 1);
+               break;
+            }
+         }
+      }
+   }
+
+   m_levelMask.store(mask, std::memory_order_relaxed);
 }
 
 //static
@@ -81,35 +265,88 @@ void logger::Logger::write(const Level::_v level, const basis::StreamString& inp
 
    const char* path = removePathBeforeCoffee(file);
 
-   const std::string string = m_formatter->apply(level, input, function, path, lineno);
+   ReadSection section;
+   const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+
+   if (snapshot == nullptr || !snapshot->formatter)
+      return;
+
+   std::string buffer;
+   const std::string* string = &buffer;
+
+   // A writer which traces while it is writing would overwrite the line kept by the formatter
+   if (section.isNested())
+      buffer = snapshot->formatter->apply(level, input, function, path, lineno);
+   else
+      string = &snapshot->formatter->format(level, input, function, path, lineno, buffer);
 
-   for (auto writer : m_writers) {
+   for (const auto& writer : snapshot->writers) {
       if (writer->wantsToProcess(level)) {
-         writer->apply(level, string);
+         writer->apply(level, *string);
       }
    }
 }
 
 //static
-bool logger::Logger::wantsToProcess(const Level::_v level)
+void logger::Logger::write(const Level::_v level, const basis::StreamString& input, const Fields& fields, const char* function, const char* file, const unsigned lineno)
    noexcept
 {
-   if(m_writers.empty() || !m_formatter)
-      return false;
+   const Fields* previous = Fields::setCurrent(&fields);
+   write(level, input, function, file, lineno);
+   Fields::setCurrent(previous);
+}
 
-   bool result = false;
-   for (auto writer : m_writers) {
-      if (writer->wantsToProcess(level)) {
-         result = true;
-         break;
+//static
+void logger::Logger::write(const Record& record)
+   noexcept
+{
+   const Level::_v level = record.getSite()->getLevel();
+
+   if (!wantsToProcess(level))
+      return;
+
+   ReadSection section;
+   const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+
+   if (snapshot == nullptr || !snapshot->formatter)
+      return;
+
+   std::string string;
+   bool formatted = false;
+
+   for (const auto& writer : snapshot->writers) {
+      if (!writer->wantsToProcess(level) || writer->applyRecord(level, record))
+         continue;
+
+      if (!formatted) {
+         format(record.getData(), string);
+         formatted = true;
       }
+
+      writer->apply(level, string);
    }
+}
+
+//static
+void logger::Logger::format(const std::string& record, std::string& output)
+   noexcept
+{
+   Record::Header header;
+   basis::StreamString message;
 
-   if (result == false)
-      return false;
+   output.clear();
 
-   return isActive(level) ? true: result;
-}
+   if (!Record::decode(record.data(), record.size(), header, message))
+      return;
 
+   ReadSection section;
+   const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
 
+   if (snapshot == nullptr || !snapshot->formatter) {
+      output.swap(message);
+      return;
+   }
 
+   const RecordSite& site = *header.site;
+   output = snapshot->formatter->apply(site.getLevel(), message, site.getFunction(), site.getFile(), site.getLine(), header.timestamp, header.thread);
+}
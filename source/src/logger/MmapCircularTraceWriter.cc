@@ -0,0 +1,228 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <iostream>
+#include <fstream>
+#include <new>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <coffee/logger/MmapCircularTraceWriter.hpp>
+
+using namespace coffee;
+
+//static
+const int logger::MmapCircularTraceWriter::MinimalKbSize;
+//static
+const int logger::MmapCircularTraceWriter::HeaderSize;
+
+namespace {
+   const char Magic[8] = { 'c', 'o', 'f', 'f', 'e', 'e', 'm', 'c' };
+   const uint32_t Version = 1;
+}
+
+struct logger::MmapCircularTraceWriter::Header {
+   char magic[sizeof(Magic)];
+   uint32_t version;
+   uint32_t headerSize;
+   uint64_t capacity;
+   std::atomic<uint64_t> position;
+};
+
+logger::MmapCircularTraceWriter::MmapCircularTraceWriter(const std::string& path, const size_t maxKbSize) :
+   logger::Writer("MmapCircularTraceWriter"),
+   m_path(path),
+   m_capacity(std::max(size_t(MinimalKbSize), maxKbSize) * 1024),
+   m_header(nullptr),
+   m_data(nullptr)
+{
+   static_assert(sizeof(Header) <= HeaderSize, "Header does not fit");
+}
+
+// The file is reused if it was created with the same size, so the lines written before the last restart are kept.
+void logger::MmapCircularTraceWriter::initialize()
+   throw(basis::RuntimeException)
+{
+   unmap();
+
+   const size_t fileSize = HeaderSize + m_capacity;
+
+   int stream = open(m_path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+   if (stream == -1)
+      COFFEE_THROW_EXCEPTION("Can not open file: " << m_path << ". Error: " << strerror(errno));
+
+   struct stat data;
+
+   if (fstat(stream, &data) == -1) {
+      ::close(stream);
+      COFFEE_THROW_EXCEPTION("Can not get file length: " << m_path << ". Error: " << strerror(errno));
+   }
+
+   const bool reused = size_t(data.st_size) == fileSize;
+
+   if (!reused && ftruncate(stream, fileSize) == -1) {
+      ::close(stream);
+      COFFEE_THROW_EXCEPTION("Can not set file length: " << m_path << ". Error: " << strerror(errno));
+   }
+
+   // Reserves the blocks now, otherwise a full disk would be reported as SIGBUS while writing a line
+   const int error = posix_fallocate(stream, 0, fileSize);
+   if (error != 0 && error != EOPNOTSUPP && error != EINVAL) {
+      ::close(stream);
+      COFFEE_THROW_EXCEPTION("Can not allocate file: " << m_path << ". Error: " << strerror(error));
+   }
+
+   void* address = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, stream, 0);
+   ::close(stream);
+
+   if (address == MAP_FAILED)
+      COFFEE_THROW_EXCEPTION("Can not map file: " << m_path << ". Error: " << strerror(errno));
+
+   Header* header = (Header*) address;
+   char* ring = (char*) address + HeaderSize;
+
+   if (!reused || memcmp(header->magic, Magic, sizeof(Magic)) != 0 || header->version != Version || header->headerSize != HeaderSize || header->capacity != m_capacity) {
+      if (reused)
+         memset(ring, 0, m_capacity);
+      memcpy(header->magic, Magic, sizeof(Magic));
+      header->version = Version;
+      header->headerSize = HeaderSize;
+      header->capacity = m_capacity;
+      new (&header->position) std::atomic<uint64_t>(0);
+   }
+
+   m_header = header;
+   m_data = ring;
+
+   levelsChanged();
+}
+
+void logger::MmapCircularTraceWriter::apply(const Level::_v level, const std::string& line)
+   noexcept
+{
+   if (m_header == nullptr) {
+      if (level <= Level::Error) {
+         std::cerr << line << std::endl;
+      }
+      return;
+   }
+
+   const size_t size = std::min(line.size(), m_capacity - 1);
+   const uint64_t position = m_header->position.fetch_add(size + 1, std::memory_order_relaxed);
+
+   copy(position, line.data(), size);
+   copy(position + size, "\n", 1);
+}
+
+// When there is some kind of error over the file, it will only trace error's
+bool logger::MmapCircularTraceWriter::wantsToProcess(const logger::Level::_v level) const
+   noexcept
+{
+   return(m_header != nullptr) ? logger::Writer::wantsToProcess(level): level <= Level::Error;
+}
+
+uint64_t logger::MmapCircularTraceWriter::getPosition() const
+   noexcept
+{
+   return (m_header == nullptr) ? 0: m_header->position.load(std::memory_order_relaxed);
+}
+
+void logger::MmapCircularTraceWriter::copy(uint64_t position, const char* data, size_t size)
+   noexcept
+{
+   const size_t offset = position % m_capacity;
+   const size_t first = std::min(size, m_capacity - offset);
+
+   memcpy(m_data + offset, data, first);
+
+   if (first < size)
+      memcpy(m_data, data + first, size - first);
+}
+
+void logger::MmapCircularTraceWriter::unmap()
+   noexcept
+{
+   if (m_header == nullptr)
+      return;
+
+   munmap(m_header, HeaderSize + m_capacity);
+   m_header = nullptr;
+   m_data = nullptr;
+
+   levelsChanged();
+}
+
+//static
+std::string logger::MmapCircularTraceWriter::extract(const std::string& path)
+   throw(basis::RuntimeException)
+{
+   std::ifstream file(path, std::ios::binary);
+
+   if (!file)
+      COFFEE_THROW_EXCEPTION("Can not open file: " << path);
+
+   std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+   if (content.size() < size_t(HeaderSize))
+      COFFEE_THROW_EXCEPTION(path << " is too short");
+
+   const Header* header = (const Header*) content.data();
+
+   if (memcmp(header->magic, Magic, sizeof(Magic)) != 0 || header->version != Version || header->headerSize != HeaderSize
+      || header->capacity == 0 || content.size() != HeaderSize + header->capacity)
+   {
+      COFFEE_THROW_EXCEPTION(path << " was not written by MmapCircularTraceWriter");
+   }
+
+   const char* ring = content.data() + HeaderSize;
+   const uint64_t capacity = header->capacity;
+   const uint64_t position = header->position.load(std::memory_order_relaxed);
+
+   std::string result;
+
+   if (position <= capacity) {
+      result.assign(ring, position);
+   }
+   else {
+      const size_t offset = position % capacity;
+      result.assign(ring + offset, capacity - offset);
+      result.append(ring, offset);
+
+      // The oldest line was partially overwritten
+      const size_t newline = result.find('\n');
+      result.erase(0, (newline == std::string::npos) ? 0: newline + 1);
+   }
+
+   // Room reserved by lines which were not completed
+   result.erase(std::remove(result.begin(), result.end(), '\0'), result.end());
+
+   return result;
+}
@@ -0,0 +1,217 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <mutex>
+#include <vector>
+
+#include <string.h>
+
+#include <coffee/logger/Record.hpp>
+
+using namespace coffee;
+
+namespace {
+
+struct Sites {
+   std::mutex mutex;
+   std::vector<const logger::RecordSite*> sites;
+};
+
+// Never released so the sites can be decoded while the process is finishing.
+Sites& getSites() noexcept {
+   static Sites* sites = new Sites;
+   return *sites;
+}
+
+template <typename T> bool read(const char*& data, const char* end, T& value) noexcept {
+   if (data + sizeof(T) > end)
+      return false;
+
+   memcpy(&value, data, sizeof(T));
+   data += sizeof(T);
+   return true;
+}
+
+bool readValue(const char*& data, const char* end, basis::StreamString& message) noexcept {
+   char type;
+
+   if (!read(data, end, type))
+      return false;
+
+   switch (type) {
+   case logger::Record::Type::Signed: {
+      int64_t value;
+      if (!read(data, end, value))
+         return false;
+      message << value;
+      break;
+   }
+   case logger::Record::Type::Unsigned: {
+      uint64_t value;
+      if (!read(data, end, value))
+         return false;
+      message << value;
+      break;
+   }
+   case logger::Record::Type::Real: {
+      double value;
+      if (!read(data, end, value))
+         return false;
+      message << value;
+      break;
+   }
+   case logger::Record::Type::Boolean: {
+      char value;
+      if (!read(data, end, value))
+         return false;
+      message << (value != 0);
+      break;
+   }
+   case logger::Record::Type::Character: {
+      char value;
+      if (!read(data, end, value))
+         return false;
+      message << value;
+      break;
+   }
+   case logger::Record::Type::Text: {
+      uint32_t size;
+      if (!read(data, end, size) || data + size > end)
+         return false;
+      message.append(data, size);
+      data += size;
+      break;
+   }
+   default:
+      return false;
+   }
+
+   return true;
+}
+
+}
+
+logger::RecordSite::RecordSite(const Level::_v level, const char* format, const char* function, const char* file, const unsigned line)
+   noexcept :
+   m_level(level),
+   m_format(format),
+   m_function(function),
+   m_file(removePathBeforeCoffee(file)),
+   m_line(line)
+{
+   Sites& sites = getSites();
+   std::lock_guard<std::mutex> guard(sites.mutex);
+   m_id = sites.sites.size();
+   sites.sites.push_back(this);
+}
+
+//static
+const logger::RecordSite* logger::RecordSite::find(const unsigned id)
+   noexcept
+{
+   Sites& sites = getSites();
+   std::lock_guard<std::mutex> guard(sites.mutex);
+   return (id < sites.sites.size()) ? sites.sites[id]: nullptr;
+}
+
+//static
+logger::Record& logger::Record::getThreadRecord()
+   noexcept
+{
+   static thread_local Record record;
+   return record;
+}
+
+void logger::Record::putHeader(const RecordSite& site)
+   noexcept
+{
+   const uint32_t id = site.getId();
+   const int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+   const pthread_t thread = pthread_self();
+
+   putRaw(&id, sizeof(id));
+   putRaw(&nanoseconds, sizeof(nanoseconds));
+   putRaw(&thread, sizeof(thread));
+}
+
+void logger::Record::putValue(const char* value)
+   noexcept
+{
+   if (value == nullptr)
+      putText("<null>", 6);
+   else
+      putText(value, strlen(value));
+}
+
+void logger::Record::putText(const char* data, const size_t size)
+   noexcept
+{
+   const uint32_t length = size;
+   putType(Type::Text);
+   putRaw(&length, sizeof(length));
+   m_buffer.append(data, length);
+}
+
+//static
+bool logger::Record::decode(const char* data, const size_t size, Header& header, basis::StreamString& message)
+   noexcept
+{
+   const char* end = data + size;
+   uint32_t id;
+   int64_t nanoseconds;
+
+   if (!read(data, end, id) || !read(data, end, nanoseconds) || !read(data, end, header.thread))
+      return false;
+
+   if ((header.site = RecordSite::find(id)) == nullptr)
+      return false;
+
+   header.timestamp = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+
+   const char* format = header.site->getFormat();
+
+   while (*format != 0) {
+      const char* placeholder = strstr(format, "{}");
+
+      if (placeholder == nullptr) {
+         message.append(format);
+         break;
+      }
+
+      message.append(format, placeholder - format);
+      format = placeholder + 2;
+
+      if (data == end)
+         message.append("{}");
+      else if (!readValue(data, end, message))
+         return false;
+   }
+
+   while (data != end) {
+      message << ' ';
+      if (!readValue(data, end, message))
+         return false;
+   }
+
+   return true;
+}
@@ -0,0 +1,255 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <iostream>
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+#include <algorithm>
+
+#include <coffee/logger/SysLogSocketWriter.hpp>
+
+using namespace coffee;
+
+//static
+const int logger::SysLogSocketWriter::NullStream = -1;
+//static
+const int logger::SysLogSocketWriter::MaxMessageSize;
+//static
+const int logger::SysLogSocketWriter::MaxBatchLines;
+//static
+const int logger::SysLogSocketWriter::DefaultFacility;
+//static
+const char* logger::SysLogSocketWriter::DefaultPath = "/dev/log";
+
+namespace {
+
+bool isDisconnected(const int error) noexcept {
+   return error == ECONNREFUSED || error == ENOTCONN || error == ENOENT;
+}
+
+bool isFull(const int error) noexcept {
+   return error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS;
+}
+
+}
+
+logger::SysLogSocketWriter::SysLogSocketWriter(const std::string& ident, const std::string& path, const int facility) :
+   logger::Writer("SysLogSocketWriter"),
+   m_ident(ident),
+   m_path(path),
+   m_facility(facility),
+   m_stream(NullStream),
+   m_sentCounter(0),
+   m_droppedCounter(0)
+{
+}
+
+logger::SysLogSocketWriter::~SysLogSocketWriter()
+{
+   closeStream();
+}
+
+void logger::SysLogSocketWriter::initialize()
+   throw(basis::RuntimeException)
+{
+   closeStream();
+
+   m_tag = m_ident + "[" + std::to_string(getpid()) + "]: ";
+
+   for (int severity = 0; severity < 8; ++ severity) {
+      m_priorities[severity] = "<" + std::to_string(m_facility | severity) + ">";
+   }
+
+   connect();
+}
+
+void logger::SysLogSocketWriter::connect()
+   throw(basis::RuntimeException)
+{
+   sockaddr_un address;
+
+   if (m_path.size() >= sizeof(address.sun_path))
+      COFFEE_THROW_EXCEPTION("Path is too long: " << m_path);
+
+   int stream = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+   if (stream == -1)
+      COFFEE_THROW_EXCEPTION("Can not create socket. Error: " << strerror(errno));
+
+   memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   memcpy(address.sun_path, m_path.c_str(), m_path.size());
+
+   if (::connect(stream, (sockaddr*) &address, sizeof(address)) == -1) {
+      const int error = errno;
+      ::close(stream);
+      COFFEE_THROW_EXCEPTION("Can not connect to " << m_path << ". Error: " << strerror(error));
+   }
+
+   m_stream = stream;
+
+   levelsChanged();
+}
+
+// The syslog daemon could have been restarted, a datagram socket can be connected again without closing it.
+bool logger::SysLogSocketWriter::reconnect()
+   noexcept
+{
+   std::lock_guard<std::mutex> guard(m_mutex);
+
+   sockaddr_un address;
+   memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   memcpy(address.sun_path, m_path.c_str(), m_path.size());
+
+   return ::connect(m_stream, (sockaddr*) &address, sizeof(address)) == 0;
+}
+
+void logger::SysLogSocketWriter::apply(const Level::_v level, const std::string& line)
+   noexcept
+{
+   if (m_stream == NullStream) {
+      if (level <= Level::Error) {
+         std::cerr << line << std::endl;
+      }
+      return;
+   }
+
+   const std::string& priority = getPriority(level);
+
+   iovec buffers[3] = {
+      { (void*) priority.data(), priority.size() },
+      { (void*) m_tag.data(), m_tag.size() },
+      { (void*) line.data(), std::min(line.size(), size_t(MaxMessageSize)) }
+   };
+
+   msghdr message;
+   memset(&message, 0, sizeof(message));
+   message.msg_iov = buffers;
+   message.msg_iovlen = 3;
+
+   for (int retry = 0; retry < 2; ++ retry) {
+      if (sendmsg(m_stream, &message, MSG_DONTWAIT | MSG_NOSIGNAL) != -1) {
+         m_sentCounter.fetch_add(1, std::memory_order_relaxed);
+         return;
+      }
+
+      if (!isDisconnected(errno) || !reconnect())
+         break;
+   }
+
+   m_droppedCounter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void logger::SysLogSocketWriter::applyBatch(const Line* lines, const size_t size)
+   noexcept
+{
+   if (m_stream == NullStream) {
+      Writer::applyBatch(lines, size);
+      return;
+   }
+
+   mmsghdr messages[MaxBatchLines];
+   iovec buffers[MaxBatchLines * 3];
+   bool reconnected = false;
+   size_t first = 0;
+
+   while (first < size) {
+      const size_t count = std::min(size - first, size_t(MaxBatchLines));
+
+      memset(messages, 0, sizeof(mmsghdr) * count);
+
+      for (size_t ii = 0; ii < count; ++ ii) {
+         const Line& line = lines[first + ii];
+         const std::string& priority = getPriority(line.first);
+         iovec* buffer = &buffers[ii * 3];
+
+         buffer[0].iov_base = (void*) priority.data();
+         buffer[0].iov_len = priority.size();
+         buffer[1].iov_base = (void*) m_tag.data();
+         buffer[1].iov_len = m_tag.size();
+         buffer[2].iov_base = (void*) line.second.data();
+         buffer[2].iov_len = std::min(line.second.size(), size_t(MaxMessageSize));
+
+         messages[ii].msg_hdr.msg_iov = buffer;
+         messages[ii].msg_hdr.msg_iovlen = 3;
+      }
+
+      const int sent = sendmmsg(m_stream, messages, count, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+      if (sent > 0) {
+         m_sentCounter.fetch_add(sent, std::memory_order_relaxed);
+         first += sent;
+         continue;
+      }
+
+      const int error = errno;
+
+      if (isDisconnected(error) && !reconnected) {
+         reconnected = true;
+         if (reconnect())
+            continue;
+      }
+
+      if (isFull(error) || isDisconnected(error)) {
+         // The next ones would fail as well, they are dropped to avoid stalling the caller
+         m_droppedCounter.fetch_add(size - first, std::memory_order_relaxed);
+         return;
+      }
+
+      m_droppedCounter.fetch_add(1, std::memory_order_relaxed);
+      ++ first;
+   }
+}
+
+// When the socket could not be connected, it will only trace error's
+bool logger::SysLogSocketWriter::wantsToProcess(const logger::Level::_v level) const
+   noexcept
+{
+   return(m_stream != NullStream) ? logger::Writer::wantsToProcess(level): level <= Level::Error;
+}
+
+void logger::SysLogSocketWriter::closeStream()
+   noexcept
+{
+   if (m_stream == NullStream)
+      return;
+
+   ::close(m_stream);
+   m_stream = NullStream;
+
+   levelsChanged();
+}
+
+const std::string& logger::SysLogSocketWriter::getPriority(const Level::_v level) const
+   noexcept
+{
+   return m_priorities[std::min(level, Level::Debug)];
+}
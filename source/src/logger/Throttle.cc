@@ -0,0 +1,137 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <algorithm>
+
+#include <coffee/basis/StreamString.hpp>
+
+#include <coffee/logger/Throttle.hpp>
+
+using namespace coffee;
+
+//static
+const std::chrono::seconds logger::Throttle::SummaryPeriod(60);
+
+//static
+const char* logger::Throttle::Mode::asString(const Mode::_v value)
+   noexcept
+{
+   static const char* names[] = { "EveryN", "Rate", "FirstN" };
+   return names[value];
+}
+
+logger::Throttle::Throttle(const Mode::_v mode, const unsigned value, const std::chrono::milliseconds& summaryPeriod)
+   noexcept :
+   m_mode(mode),
+   m_value(std::max(value, 1U)),
+   m_interval(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds(1)).count() / m_value),
+   m_summaryPeriod(std::chrono::duration_cast<std::chrono::nanoseconds>(summaryPeriod).count()),
+   m_counter(0),
+   m_suppressed(0),
+   m_theoreticalArrival(0),
+   m_lastSummary(now())
+{
+}
+
+bool logger::Throttle::accept(unsigned& suppressed)
+   noexcept
+{
+   if (select()) {
+      suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+      return true;
+   }
+
+   m_suppressed.fetch_add(1, std::memory_order_relaxed);
+   suppressed = 0;
+   return false;
+}
+
+bool logger::Throttle::summarize(unsigned& suppressed)
+   noexcept
+{
+   const int64_t current = now();
+   int64_t last = m_lastSummary.load(std::memory_order_relaxed);
+
+   if (current - last < m_summaryPeriod)
+      return false;
+
+   // Only one of the threads which reach the end of the period writes the summary
+   if (!m_lastSummary.compare_exchange_strong(last, current, std::memory_order_relaxed))
+      return false;
+
+   suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+   return suppressed > 0;
+}
+
+// Rate uses the generic cell rate algorithm: every trace moves the theoretical arrival time one interval
+// forward, and a trace is rejected when it would be more than one second ahead of now.
+bool logger::Throttle::select()
+   noexcept
+{
+   switch (m_mode) {
+   case Mode::EveryN:
+      return (m_counter.fetch_add(1, std::memory_order_relaxed) % m_value) == 0;
+
+   case Mode::FirstN:
+      if (m_counter.load(std::memory_order_relaxed) >= m_value)
+         return false;
+      return m_counter.fetch_add(1, std::memory_order_relaxed) < m_value;
+
+   case Mode::Rate: {
+      const int64_t current = now();
+      const int64_t tolerance = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds(1)).count() - m_interval;
+      int64_t arrival = m_theoreticalArrival.load(std::memory_order_relaxed);
+
+      for (;;) {
+         const int64_t start = std::max(arrival, current);
+
+         if (start - current > tolerance)
+            return false;
+
+         if (m_theoreticalArrival.compare_exchange_weak(arrival, start + m_interval, std::memory_order_relaxed))
+            return true;
+      }
+   }
+   }
+
+   return true;
+}
+
+//static
+void logger::Throttle::write(const Level::_v level, basis::StreamString& message, const unsigned suppressed, const char* function, const char* file, const unsigned line)
+   noexcept
+{
+   if (suppressed > 0)
+      message << " [" << suppressed << " similar traces suppressed]";
+
+   Logger::write(level, message, function, file, line);
+}
+
+//static
+void logger::Throttle::writeSummary(const Level::_v level, const unsigned suppressed, const char* function, const char* file, const unsigned line)
+   noexcept
+{
+   basis::StreamString message;
+   message << suppressed << " similar traces suppressed";
+   Logger::write(level, message, function, file, line);
+}
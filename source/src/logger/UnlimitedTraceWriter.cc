@@ -31,8 +31,6 @@
 #include <sys/types.h>
 #include <string.h>
 
-#include <algorithm>
-
 #include <coffee/logger/UnlimitedTraceWriter.hpp>
 
 using namespace coffee;
@@ -62,13 +60,20 @@ void logger::UnlimitedTraceWriter::apply(const Level::_v level, const std::strin
       return;
    }
 
-   try {
-      write(m_stream, line.data(), line.length());
-      write(m_stream, "\n", 1);
-   }
-   catch(basis::RuntimeException& ex) {
-      std::cerr << ex.what() << std::endl;
+   if (writeLine(m_stream, line) == false)
+      std::cerr << "Can not write on file: " << m_path << ". Error: " << strerror(errno) << std::endl;
+}
+
+void logger::UnlimitedTraceWriter::applyBatch(const Line* lines, const size_t size)
+   noexcept
+{
+   if (m_stream == NullStream) {
+      Writer::applyBatch(lines, size);
+      return;
    }
+
+   if (writeLines(m_stream, lines, size) == false)
+      std::cerr << "Can not write on file: " << m_path << ". Error: " << strerror(errno) << std::endl;
 }
 
 // When there is some kind of error over the stream, it will only trace error's
@@ -89,6 +94,8 @@ void coffee::logger::UnlimitedTraceWriter::openStream()
    m_stream = stream;
 
    fcntl(stream, F_SETFL, fcntl(stream, F_GETFL) | O_NONBLOCK);
+
+   levelsChanged();
 }
 
 void logger::UnlimitedTraceWriter::closeStream()
@@ -98,6 +105,8 @@ void logger::UnlimitedTraceWriter::closeStream()
       ::close(m_stream);
 
    m_stream = NullStream;
+
+   levelsChanged();
 }
 
 
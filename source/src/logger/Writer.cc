@@ -21,14 +21,108 @@
 // SOFTWARE.
 //
 
+#include <errno.h>
+#include <limits.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+
 #include <coffee/logger/Writer.hpp>
 #include <coffee/logger/Logger.hpp>
 
 using namespace coffee;
 
+namespace {
+
+// Every line needs two buffers, the text and the new line
+const size_t MaxLinesPerCall = IOV_MAX / 2;
+
+bool writeBuffers(const int stream, iovec* buffers, int count)
+   noexcept
+{
+   while (count > 0) {
+      const ssize_t written = writev(stream, buffers, count);
+
+      if (written < 0) {
+         if (errno == EINTR)
+            continue;
+         return false;
+      }
+
+      size_t pending = written;
+
+      while (count > 0 && pending >= buffers->iov_len) {
+         pending -= buffers->iov_len;
+         ++ buffers;
+         -- count;
+      }
+
+      if (count > 0) {
+         if (written == 0) {
+            errno = EIO;
+            return false;
+         }
+
+         buffers->iov_base = (char*) buffers->iov_base + pending;
+         buffers->iov_len -= pending;
+      }
+   }
+
+   return true;
+}
+
+}
+
 // virtual
 bool logger::Writer::wantsToProcess (const logger::Level::_v level) const
    noexcept
 {
    return Logger::isActive(level);
 }
+
+// virtual
+void logger::Writer::applyBatch(const Line* lines, const size_t size)
+   noexcept
+{
+   for (size_t ii = 0; ii < size; ++ ii) {
+      apply(lines[ii].first, lines[ii].second);
+   }
+}
+
+//static
+bool logger::Writer::writeLine(const int stream, const std::string& line)
+   noexcept
+{
+   iovec buffers[2] = { { (void*) line.data(), line.length() }, { (void*) "\n", 1 } };
+   return writeBuffers(stream, buffers, 2);
+}
+
+//static
+bool logger::Writer::writeLines(const int stream, const Line* lines, const size_t size)
+   noexcept
+{
+   iovec buffers[MaxLinesPerCall * 2];
+
+   for (size_t first = 0; first < size; first += MaxLinesPerCall) {
+      const size_t count = std::min(size - first, MaxLinesPerCall);
+
+      for (size_t ii = 0; ii < count; ++ ii) {
+         const std::string& line = lines[first + ii].second;
+         buffers[ii * 2].iov_base = (void*) line.data();
+         buffers[ii * 2].iov_len = line.length();
+         buffers[ii * 2 + 1].iov_base = (void*) "\n";
+         buffers[ii * 2 + 1].iov_len = 1;
+      }
+
+      if (writeBuffers(stream, buffers, count * 2) == false)
+         return false;
+   }
+
+   return true;
+}
+
+void logger::Writer::levelsChanged() const
+   noexcept
+{
+   Logger::refreshLevelMask();
+}
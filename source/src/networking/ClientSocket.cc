@@ -21,9 +21,12 @@
 // SOFTWARE.
 //
 
+#include <errno.h>
+
 #include <coffee/networking/ClientSocket.hpp>
 #include <coffee/networking/MessageHandler.hpp>
 #include <coffee/logger/Logger.hpp>
+#include <coffee/time/Deadline.hpp>
 
 using namespace coffee;
 
@@ -44,6 +47,11 @@ void networking::ClientSocket::initialize()
       m_zmqSocket->setsockopt(ZMQ_SNDTIMEO, &value, sizeof(int));
       m_zmqSocket->setsockopt(ZMQ_RCVTIMEO, &value, sizeof(int));
       m_zmqSocket->setsockopt(ZMQ_LINGER, &value, sizeof(int));
+
+      // A request without response must not block the following ones, and its late response must be discarded
+      value = 1;
+      m_zmqSocket->setsockopt(ZMQ_REQ_RELAXED, &value, sizeof(int));
+      m_zmqSocket->setsockopt(ZMQ_REQ_CORRELATE, &value, sizeof(int));
    }
    catch(zmq::error_t& ex) {
       COFFEE_THROW_EXCEPTION(asString() << ",Error=" << ex.what());
@@ -79,6 +87,58 @@ basis::DataBlock networking::ClientSocket::send(const basis::DataBlock& request)
    return basis::DataBlock ((char*) zmqResponse.data(), zmqResponse.size());
 }
 
+basis::DataBlock networking::ClientSocket::send(const basis::DataBlock& request, const std::shared_ptr<time::Deadline>& deadline)
+   throw(basis::RuntimeException)
+{
+   if (deadline->isExpired()) {
+      COFFEE_THROW_EXCEPTION(asString() << " | " << deadline->asString() << " expired before sending the request");
+   }
+
+   zmq::message_t zmqResponse;
+
+   try {
+      zmq::message_t zmqRequest(request.size());
+      coffee_memcpy(zmqRequest.data(), request.data(), request.size());
+      if (!m_zmqSocket->send(zmqRequest, ZMQ_DONTWAIT)) {
+         COFFEE_THROW_EXCEPTION(asString() << ",Error=Socket could not send the message");
+      }
+
+      // The deadline expired by the TimeService wakes up the poll, its own time limit is only a guard
+      zmq_pollitem_t items[2];
+      coffee_memset(items, 0, sizeof(items));
+      items[0].socket = (void*) *m_zmqSocket;
+      items[0].events = ZMQ_POLLIN;
+      items[1].fd = deadline->getFileDescriptor();
+      items[1].events = ZMQ_POLLIN;
+
+      while (true) {
+         if (deadline->isExpired()) {
+            COFFEE_THROW_EXCEPTION(asString() << " | " << deadline->asString() << " expired before receiving any response");
+         }
+
+         const int rpoll = zmq_poll(items, 2, deadline->getRemaining().count());
+
+         if (rpoll < 0) {
+            const int error = zmq_errno();
+
+            // A signal does not consume the deadline
+            if (error == EINTR)
+               continue;
+
+            COFFEE_THROW_EXCEPTION(asString() << ",Error=" << zmq_strerror(error));
+         }
+
+         if ((items[0].revents & ZMQ_POLLIN) && m_zmqSocket->recv(&zmqResponse, ZMQ_DONTWAIT))
+            break;
+      }
+   }
+   catch(zmq::error_t& ex) {
+      COFFEE_THROW_EXCEPTION(asString() << ",Error=" << ex.what());
+   }
+
+   return basis::DataBlock ((char*) zmqResponse.data(), zmqResponse.size());
+}
+
 basis::StreamString networking::ClientSocket::asString() const
    noexcept
 {
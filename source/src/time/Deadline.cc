@@ -0,0 +1,120 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <coffee/basis/AsString.hpp>
+
+#include <coffee/logger/Logger.hpp>
+
+#include <coffee/time/Deadline.hpp>
+#include <coffee/time/TimeService.hpp>
+
+using namespace coffee;
+
+using std::chrono::milliseconds;
+
+namespace {
+   // Every deadline gets its own identifier, so the traces of several of them could be told apart
+   std::atomic<time::TimeEvent::Id> deadlineIds(0);
+}
+
+time::Deadline::Deadline(TimeService& _timeService, const milliseconds& timeout)
+   throw(basis::RuntimeException) :
+   TimeEvent(++ deadlineIds, timeout),
+   timeService(_timeService),
+   limit(std::chrono::steady_clock::now() + timeout),
+   expired(false),
+   eventFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+   if (eventFd < 0) {
+      COFFEE_THROW_EXCEPTION("Deadline can not create the event. Error: " << strerror(errno));
+   }
+}
+
+time::Deadline::~Deadline()
+{
+   if (eventFd >= 0)
+      close(eventFd);
+}
+
+//static
+std::shared_ptr<time::Deadline> time::Deadline::instantiate(TimeService& timeService, const milliseconds& timeout)
+   throw(basis::RuntimeException)
+{
+   std::shared_ptr<Deadline> result(new Deadline(timeService, timeout));
+   timeService.activate(result);
+   return result;
+}
+
+bool time::Deadline::isExpired() const
+   noexcept
+{
+   return expired.load(std::memory_order_acquire) || std::chrono::steady_clock::now() >= limit;
+}
+
+milliseconds time::Deadline::getRemaining() const
+   noexcept
+{
+   if (expired.load(std::memory_order_acquire))
+      return milliseconds::zero();
+
+   const auto now = std::chrono::steady_clock::now();
+
+   if (now >= limit)
+      return milliseconds::zero();
+
+   // Rounded up, so waiting for the remaining time always reaches the limit
+   return std::chrono::duration_cast<milliseconds>(limit - now + milliseconds(1) - std::chrono::nanoseconds(1));
+}
+
+void time::Deadline::cancel()
+   noexcept
+{
+   timeService.cancel(shared_from_this());
+}
+
+bool time::Deadline::expire()
+   noexcept
+{
+   expired.store(true, std::memory_order_release);
+
+   const uint64_t value = 1;
+   if (write(eventFd, &value, sizeof(value)) < 0) {
+      LOG_WARN(asString() << " | Error=" << strerror(errno));
+   }
+
+   return false;
+}
+
+basis::StreamString time::Deadline::asString() const
+   noexcept
+{
+   basis::StreamString result("time.Deadline {");
+   result << TimeEvent::asString();
+   result << " | IsExpired=" << basis::AsString::apply(isExpired());
+   return result << "}";
+}
@@ -0,0 +1,145 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <algorithm>
+
+#include <coffee/basis/AsString.hpp>
+
+#include <coffee/xml/Node.hpp>
+
+#include <coffee/time/Histogram.hpp>
+
+using namespace coffee;
+
+using std::chrono::microseconds;
+
+//static
+const int time::Histogram::MaxBuckets;
+
+time::Histogram::Histogram(const std::string& _name) :
+   name(_name),
+   counter(0),
+   sum(0),
+   max(0)
+{
+   for (auto& bucket : buckets) {
+      bucket = 0;
+   }
+}
+
+//static
+int time::Histogram::calculeBucket(const uint64_t value)
+   noexcept
+{
+   if (value == 0)
+      return 0;
+
+   const int result = 64 - __builtin_clzll(value);
+
+   return (result < MaxBuckets) ? result: MaxBuckets - 1;
+}
+
+void time::Histogram::add(const microseconds& value)
+   noexcept
+{
+   const uint64_t count = (value.count() > 0) ? value.count(): 0;
+
+   buckets[calculeBucket(count)].fetch_add(1, std::memory_order_relaxed);
+   counter.fetch_add(1, std::memory_order_relaxed);
+   sum.fetch_add(count, std::memory_order_relaxed);
+
+   uint64_t maxCount = max.load(std::memory_order_relaxed);
+   while (count > maxCount && !max.compare_exchange_weak(maxCount, count, std::memory_order_relaxed));
+}
+
+microseconds time::Histogram::getAverage() const
+   noexcept
+{
+   const uint64_t values = getCounter();
+   return (values == 0) ? microseconds::zero(): microseconds(sum.load(std::memory_order_relaxed) / values);
+}
+
+microseconds time::Histogram::getPercentile(const double percentile) const
+   noexcept
+{
+   uint64_t values = 0;
+   uint64_t counters[MaxBuckets];
+
+   for (int ii = 0; ii < MaxBuckets; ++ ii) {
+      values += (counters[ii] = getBucketCounter(ii));
+   }
+
+   if (values == 0)
+      return microseconds::zero();
+
+   const double target = values * percentile / 100.0;
+   uint64_t accumulated = 0;
+
+   for (int ii = 0; ii < MaxBuckets; ++ ii) {
+      accumulated += counters[ii];
+      if (accumulated >= target && counters[ii] > 0)
+         return std::min(getUpperBound(ii), getMax());
+   }
+
+   return getMax();
+}
+
+basis::StreamString time::Histogram::asString() const
+   noexcept
+{
+   basis::StreamString result("time.Histogram { Name=");
+   result << name;
+   result << " | #Values=" << getCounter();
+   result << " | Average=" << getAverage();
+   result << " | P50=" << getPercentile(50);
+   result << " | P99=" << getPercentile(99);
+   result << " | Max=" << getMax();
+   return result << " }";
+}
+
+std::shared_ptr<xml::Node> time::Histogram::asXML(std::shared_ptr<xml::Node>& parent) const
+   throw(basis::RuntimeException)
+{
+   std::shared_ptr<xml::Node> result = parent->createChild("time.Histogram");
+
+   result->createAttribute("Name", name);
+   result->createAttribute("Counter", getCounter());
+   result->createAttribute("Average", getAverage());
+   result->createAttribute("P50", getPercentile(50));
+   result->createAttribute("P90", getPercentile(90));
+   result->createAttribute("P99", getPercentile(99));
+   result->createAttribute("Max", getMax());
+
+   for (int ii = 0; ii < MaxBuckets; ++ ii) {
+      const uint64_t bucketCounter = getBucketCounter(ii);
+
+      if (bucketCounter == 0)
+         continue;
+
+      auto bucket = result->createChild("Bucket");
+      bucket->createAttribute("UpperBound", getUpperBound(ii));
+      bucket->createAttribute("Counter", bucketCounter);
+   }
+
+   return result;
+}
@@ -30,7 +30,13 @@ using std::chrono::milliseconds;
 time::TimeEvent::TimeEvent(const Id id, const milliseconds& _timeout) :
    basis::pattern::observer::Event(id), timeout(_timeout),
    initTime(0),
-   endTime(0)
+   endTime(0),
+   expiration(0),
+   previous(nullptr),
+   next(nullptr),
+   quantum(nullptr),
+   shard(-1),
+   pending(false)
 {;}
 
 milliseconds time::TimeEvent::getDuration() const
@@ -21,18 +21,32 @@
 // SOFTWARE.
 //
 
+#include <errno.h>
+#include <string.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+
 #include <coffee/basis/AsString.hpp>
 
 #include <coffee/logger/Logger.hpp>
 #include <coffee/logger/TraceMethod.hpp>
+#include <coffee/logger/Throttle.hpp>
+
+#include <coffee/basis/pattern/observer/Observer.hpp>
 
 #include <coffee/time/TimeService.hpp>
+#include <coffee/time/CoarseClock.hpp>
 #include <coffee/time/SCCS.hpp>
 
 #include <coffee/app/Application.hpp>
 
+#include <coffee/xml/Node.hpp>
+
 using namespace coffee;
 
 using std::chrono::microseconds;
@@ -42,31 +56,107 @@ using std::chrono::milliseconds;
 const std::string time::TimeService::Implementation("native");
 
 //static
-std::shared_ptr<time::TimeService> time::TimeService::instantiate(app::Application& application, const milliseconds& maxTime, const milliseconds& resolution)
+const int time::TimeService::FirstLevelSize;
+const int time::TimeService::LevelSize;
+
+namespace {
+   // The tick would overflow beyond this number of bits
+   const int MaxTickBits = 62;
+
+   template <typename _Duration> timespec toTimespec(const _Duration& duration) {
+      const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+      timespec result;
+      result.tv_sec = nanoseconds / 1000000000;
+      result.tv_nsec = nanoseconds % 1000000000;
+      return result;
+   }
+
+   std::atomic<unsigned> threadCounter(0);
+
+   // Shard processed by the consumer running on this thread
+   struct ConsumerShard {
+      const void* owner;
+      int index;
+   };
+   thread_local ConsumerShard consumerShard = { nullptr, 0 };
+}
+
+struct time::TimeService::Shard {
+   const int index;
+   std::mutex mutex;
+   uint64_t currentTick;
+   std::vector<Quantum> wheel;
+   std::atomic<size_t> eventCounter;
+   size_t maxEventCounter;
+   int timerFd;
+   std::thread consumer;
+
+   // Events expired on the last tick, the vector is reused to notify them without holding the lock
+   std::vector<std::shared_ptr<TimeEvent> > expired;
+
+   Shard(const int _index, const int wheelSize) : index(_index), currentTick(0), wheel(wheelSize, nullptr), eventCounter(0), maxEventCounter(0), timerFd(-1) {;}
+};
+
+struct time::TimeService::Worker {
+   typedef std::pair<std::shared_ptr<basis::pattern::observer::Observer>, std::shared_ptr<TimeEvent> > Job;
+
+   std::mutex mutex;
+   std::condition_variable condition;
+   std::deque<Job> jobs;
+   bool stopped;
+   std::thread thread;
+
+   Worker() : stopped(false) {;}
+};
+
+//static
+std::shared_ptr<time::TimeService> time::TimeService::instantiate(app::Application& application, const milliseconds& maxTime, const milliseconds& resolution, const int shards, const int workers)
    throw(basis::RuntimeException)
 {
-   std::shared_ptr<TimeService> result(new TimeService(application, maxTime, resolution));
+   if (shards < 1) {
+      COFFEE_THROW_EXCEPTION("Number of shards must be greater than 0");
+   }
+
+   if (workers < 0) {
+      COFFEE_THROW_EXCEPTION("Number of workers can not be negative");
+   }
+
+   std::shared_ptr<TimeService> result(new TimeService(application, maxTime, resolution, shards, workers));
    application.attach(result);
    return result;
 }
 
-time::TimeService::TimeService(app::Application& application, const milliseconds& _maxTime, const milliseconds& _resolution) :
+time::TimeService::TimeService(app::Application& application, const milliseconds& _maxTime, const milliseconds& _resolution, const int _shards, const int _workers) :
    app::Service(application, app::Feature::Timing, Implementation),
    basis::pattern::observer::Subject("TimeService"),
    maxTime(_maxTime),
    resolution(_resolution),
    maxQuantum(calculeMaxQuantum(_maxTime, _resolution)),
-   currentQuantum(0)
+   levels(calculeLevels(maxQuantum)),
+   callbacks("Callbacks"),
+   lateness("Lateness"),
+   quantumProcessing("QuantumProcessing"),
+   drivesCoarseClock(false)
 {
    time::SCCS::activate();
 
-   timeTable = new Quantum[maxQuantum];
-   events.reserve(32);
+   for (int ii = 0; ii < _shards; ++ ii) {
+      shards.emplace_back(new Shard(ii, FirstLevelSize + (levels - 1) * LevelSize));
+   }
+
+   for (int ii = 0; ii < _workers; ++ ii) {
+      workers.emplace_back(new Worker);
+   }
 }
 
 time::TimeService::~TimeService()
 {
-   delete [] timeTable;
+   for (auto& shard : shards) {
+      clear(*shard);
+
+      if (shard->timerFd >= 0)
+         close(shard->timerFd);
+   }
 }
 
 //static
@@ -81,6 +171,21 @@ int time::TimeService::calculeMaxQuantum(const milliseconds& maxTime, const mill
    return result;
 }
 
+//static
+int time::TimeService::calculeLevels(const int maxQuantum)
+   noexcept
+{
+   int result = 2;
+   int bits = FirstLevelBits + LevelBits;
+
+   while ((bits + LevelBits) <= MaxTickBits && (uint64_t(1) << bits) < uint64_t(maxQuantum)) {
+      bits += LevelBits;
+      ++ result;
+   }
+
+   return result;
+}
+
 void time::TimeService::do_initialize()
    throw(basis::RuntimeException)
 {
@@ -88,10 +193,40 @@ void time::TimeService::do_initialize()
       COFFEE_THROW_EXCEPTION("Resolution must be lesser than " << maxTime);
    }
 
-   std::unique_lock<std::mutex> guard(mutex);
+   startTime = std::chrono::steady_clock::now();
+
+   // Absolute periodic expirations do not drift although some wake up was delayed
+   itimerspec spec;
+   spec.it_interval = toTimespec(resolution);
+   spec.it_value = toTimespec(startTime.time_since_epoch() + resolution);
+
+   for (auto& shard : shards) {
+      shard->currentTick = 0;
+      shard->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
 
-   producer = std::thread(produce, std::ref(*this));
-   consumer = std::thread(consume, std::ref(*this));
+      if (shard->timerFd < 0) {
+         COFFEE_THROW_EXCEPTION(asString() << " can not create the timer. Error: " << strerror(errno));
+      }
+
+      if (timerfd_settime(shard->timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+         COFFEE_THROW_EXCEPTION(asString() << " can not start the timer. Error: " << strerror(errno));
+      }
+   }
+
+   // Without workers the consumer runs the observers, so a slow one would let the clock go stale
+   if (resolution <= CoarseClock::getMaxDriverResolution() && !workers.empty()) {
+      CoarseClock::attach();
+      drivesCoarseClock = true;
+   }
+
+   for (auto& worker : workers) {
+      worker->stopped = false;
+      worker->thread = std::thread(work, std::ref(*this), std::ref(*worker));
+   }
+
+   for (auto& shard : shards) {
+      shard->consumer = std::thread(consume, std::ref(*this), std::ref(*shard));
+   }
 }
 
 void time::TimeService::do_stop()
@@ -100,16 +235,77 @@ void time::TimeService::do_stop()
    LOG_THIS_METHOD();
 
    statusStopped();
-   ticks.clear();
 
-   if (!events.empty()) {
-       LOG_WARN("There were " << events.size() << " events on air");
-    }
+   for (auto& shard : shards) {
+      if (shard->timerFd >= 0) {
+         // Wakes up the consumer right now
+         itimerspec spec;
+         spec.it_interval = timespec{0, 0};
+         spec.it_value = timespec{0, 1};
+         timerfd_settime(shard->timerFd, 0, &spec, nullptr);
+      }
+   }
+
+   const size_t eventCounter = size();
+
+   if (eventCounter != 0) {
+      LOG_WARN("There were " << eventCounter << " events on air");
+   }
 
-   events.clear();
-   condition.notify_all();
-   producer.join();
-   consumer.join();
+   for (auto& shard : shards) {
+      if (shard->consumer.joinable())
+         shard->consumer.join();
+
+      if (shard->timerFd >= 0) {
+         close(shard->timerFd);
+         shard->timerFd = -1;
+      }
+
+      std::unique_lock<std::mutex> guard(shard->mutex);
+      clear(*shard);
+   }
+
+   if (drivesCoarseClock) {
+      CoarseClock::detach();
+      drivesCoarseClock = false;
+   }
+
+   // Pending notifications are discarded
+   for (auto& worker : workers) {
+      if (true) {
+         std::unique_lock<std::mutex> guard(worker->mutex);
+         worker->stopped = true;
+         worker->jobs.clear();
+         worker->condition.notify_one();
+      }
+
+      if (worker->thread.joinable())
+         worker->thread.join();
+   }
+}
+
+size_t time::TimeService::size() const
+   noexcept
+{
+   size_t result = 0;
+
+   for (auto& shard : shards) {
+      result += shard->eventCounter.load(std::memory_order_relaxed);
+   }
+
+   return result;
+}
+
+time::TimeService::Shard& time::TimeService::getCurrentShard()
+   noexcept
+{
+   // Consumers work on their own shard and the other threads are spread among all of them
+   static thread_local unsigned threadIndex = threadCounter ++;
+
+   if (consumerShard.owner == this)
+      return *shards[consumerShard.index];
+
+   return *shards[threadIndex % shards.size()];
 }
 
 void time::TimeService::activate(std::shared_ptr<TimeEvent> timeEvent)
@@ -129,36 +325,172 @@ void time::TimeService::activate(std::shared_ptr<TimeEvent> timeEvent)
       COFFEE_THROW_EXCEPTION("Event duration should be greater that 0");
    }
 
-   if (timeout > maxTime || timeout < resolution) {
-      COFFEE_THROW_EXCEPTION("Timeout=" << timeout << " is out range for " << asString());
-   }
+   Shard& shard = getCurrentShard();
+
+   // The state of the event is protected by the shard where it was activated the last time, so
+   // both of them are locked, and it is retried if other thread moved the event meanwhile
+   while (true) {
+      const int owner = timeEvent->shard;
+
+      if (owner < 0 || owner == shard.index || owner >= int(shards.size())) {
+         std::unique_lock<std::mutex> guard(shard.mutex);
+
+         if (timeEvent->shard != owner)
+            continue;
+
+         activate(shard, timeEvent);
+         return;
+      }
+
+      std::unique_lock<std::mutex> guard(shard.mutex, std::defer_lock);
+      std::unique_lock<std::mutex> ownerGuard(shards[owner]->mutex, std::defer_lock);
+      std::lock(guard, ownerGuard);
 
-   std::unique_lock<std::mutex> guard(mutex);
+      if (timeEvent->shard != owner)
+         continue;
 
-   if (events.find(timeEvent->getId()) != events.end()) {
+      activate(shard, timeEvent);
+      return;
+   }
+}
+
+void time::TimeService::activate(Shard& shard, const std::shared_ptr<TimeEvent>& timeEvent)
+   throw(basis::RuntimeException)
+{
+   if (timeEvent->isActivated()) {
       COFFEE_THROW_EXCEPTION(timeEvent->getId () << " already activated");
    }
 
-   store(timeEvent, guard);
+   timeEvent->deadline = std::chrono::steady_clock::now() + timeEvent->getTimeout();
+   store(shard, timeEvent, shard.currentTick);
+
+   if (++ shard.eventCounter > shard.maxEventCounter)
+      shard.maxEventCounter = shard.eventCounter;
 }
 
-void time::TimeService::store(std::shared_ptr<TimeEvent> timeEvent, std::unique_lock<std::mutex>& guard)
+void time::TimeService::store(Shard& shard, std::shared_ptr<TimeEvent> timeEvent, const uint64_t fromTick)
    noexcept
 {
    const milliseconds& timeout = timeEvent->getTimeout();
 
-   const int indexQuantum = (currentQuantum + timeout / resolution) % maxQuantum;
+   const uint64_t ticks = timeout / resolution;
+   timeEvent->expiration = fromTick + std::max(ticks, uint64_t(1));
+   timeEvent->shard = shard.index;
 
-   Quantum* target = (indexQuantum == currentQuantum) ? &temporaryQuantum: &timeTable[indexQuantum];
-   target->push_front(timeEvent);
-   Location location(target, target->begin());
-   events[timeEvent->getId()] = location;
+   link(findQuantum(shard, timeEvent->expiration), timeEvent.get());
+   timeEvent->self = timeEvent;
 
-   auto now = std::chrono::high_resolution_clock::now();
    timeEvent->initTime = TimeService::now();
    timeEvent->endTime = milliseconds::zero();
 
-   LOG_DEBUG("Now=" << timeEvent->initTime << " | CurrentQuantum=" << currentQuantum << " | IndexQuantum=" << indexQuantum << " | " << timeEvent->asString());
+   LOG_DEBUG("Now=" << timeEvent->initTime << " | Shard=" << shard.index << " | CurrentTick=" << shard.currentTick << " | Expiration=" << timeEvent->expiration << " | " << timeEvent->asString());
+}
+
+time::TimeService::Quantum& time::TimeService::findQuantum(Shard& shard, const uint64_t tick)
+   noexcept
+{
+   const uint64_t currentTick = shard.currentTick;
+   const uint64_t delta = (tick > currentTick) ? tick - currentTick: 0;
+
+   if (delta < FirstLevelSize)
+      return shard.wheel[std::max(tick, currentTick) & (FirstLevelSize - 1)];
+
+   int shift = FirstLevelBits;
+   int offset = FirstLevelSize;
+
+   for (int level = 1; level < levels - 1; ++ level) {
+      if (delta < (uint64_t(1) << (shift + LevelBits)))
+         return shard.wheel[offset + ((tick >> shift) & (LevelSize - 1))];
+
+      shift += LevelBits;
+      offset += LevelSize;
+   }
+
+   // Longer timeouts wait on the farthest quantum of the last level and they will be relocated again once it is cascaded
+   const uint64_t maxDelta = (uint64_t(1) << (shift + LevelBits)) - 1;
+   const uint64_t target = (delta < maxDelta) ? tick: currentTick + maxDelta;
+
+   return shard.wheel[offset + ((target >> shift) & (LevelSize - 1))];
+}
+
+void time::TimeService::relocate(Shard& shard, TimeEvent* timeEvent)
+   noexcept
+{
+   unlink(timeEvent);
+   link(findQuantum(shard, timeEvent->expiration), timeEvent);
+}
+
+//static
+void time::TimeService::link(Quantum& quantum, TimeEvent* timeEvent)
+   noexcept
+{
+   timeEvent->previous = nullptr;
+   timeEvent->next = quantum;
+   timeEvent->quantum = &quantum;
+
+   if (quantum != nullptr)
+      quantum->previous = timeEvent;
+
+   quantum = timeEvent;
+}
+
+//static
+void time::TimeService::unlink(TimeEvent* timeEvent)
+   noexcept
+{
+   if (timeEvent->previous != nullptr)
+      timeEvent->previous->next = timeEvent->next;
+   else
+      *timeEvent->quantum = timeEvent->next;
+
+   if (timeEvent->next != nullptr)
+      timeEvent->next->previous = timeEvent->previous;
+
+   timeEvent->previous = timeEvent->next = nullptr;
+   timeEvent->quantum = nullptr;
+}
+
+void time::TimeService::clear(Shard& shard)
+   noexcept
+{
+   for (Quantum& quantum : shard.wheel) {
+      while (quantum != nullptr) {
+         TimeEvent* timeEvent = quantum;
+         unlink(timeEvent);
+         timeEvent->self.reset();
+      }
+   }
+
+   for (auto& timeEvent : shard.expired) {
+      timeEvent->pending = false;
+   }
+
+   shard.expired.clear();
+   shard.eventCounter = 0;
+}
+
+void time::TimeService::cascade(Shard& shard)
+   noexcept
+{
+   int shift = FirstLevelBits;
+   int offset = FirstLevelSize;
+
+   for (int level = 1; level < levels; ++ level) {
+      const int index = (shard.currentTick >> shift) & (LevelSize - 1);
+
+      // Every event goes to a lower level or, on the last level, to other quantum
+      Quantum& pending = shard.wheel[offset + index];
+
+      while (pending != nullptr) {
+         relocate(shard, pending);
+      }
+
+      if (index != 0)
+         break;
+
+      shift += LevelBits;
+      offset += LevelSize;
+   }
 }
 
 bool time::TimeService::cancel(std::shared_ptr<TimeEvent> timeEvent)
@@ -167,15 +499,28 @@ bool time::TimeService::cancel(std::shared_ptr<TimeEvent> timeEvent)
    if (!timeEvent)
       return false;
 
-   std::unique_lock<std::mutex> guard(mutex);
+   const int index = timeEvent->shard;
 
-   auto ii = events.find(timeEvent->getId());
+   if (index < 0 || index >= int(shards.size()))
+      return false;
 
-   if (ii == events.end())
+   Shard& shard = *shards[index];
+
+   std::unique_lock<std::mutex> guard(shard.mutex);
+
+   if (timeEvent->shard != index || !timeEvent->isActivated())
       return false;
 
-   ii->second.first->erase(ii->second.second);
-   events.erase(ii);
+   // It is being notified, it just will not be stored again
+   if (timeEvent->pending) {
+      timeEvent->pending = false;
+   }
+   else {
+      unlink(timeEvent.get());
+      timeEvent->self.reset();
+   }
+
+   -- shard.eventCounter;
    return true;
 }
 
@@ -187,82 +532,218 @@ basis::StreamString time::TimeService::asString() const
    result << " | MaxTime=" << maxTime;
    result << " | Resolution=" << resolution;
    result << " | MaxQuantum=" << maxQuantum;
-   result << " | #TimeEvents=" << events.size();
+   result << " | Levels=" << levels;
+   result << " | Shards=" << shards.size();
+   result << " | Workers=" << workers.size();
+   result << " | #Callbacks=" << callbacks.getCounter();
+   result << " | MaxCallbackDuration=" << callbacks.getMax();
+   result << " | Lateness={ Average=" << lateness.getAverage() << " | P99=" << lateness.getPercentile(99) << " | Max=" << lateness.getMax() << " }";
+   result << " | QuantumProcessing={ Average=" << quantumProcessing.getAverage() << " | Max=" << quantumProcessing.getMax() << " }";
+   result << " | #TimeEvents=" << size();
    return result << "}";
 }
 
+std::shared_ptr<xml::Node> time::TimeService::asXML(std::shared_ptr<xml::Node>& parent) const
+   throw(basis::RuntimeException)
+{
+   std::shared_ptr<xml::Node> result = parent->createChild("time.Service");
+
+   app::Service::asXML(result);
+
+   result->createAttribute("MaxTime", maxTime);
+   result->createAttribute("Resolution", resolution);
+   result->createAttribute("Levels", levels);
+   result->createAttribute("Workers", int(workers.size()));
+   result->createAttribute("TimeEvents", uint64_t(size()));
+
+   auto xmlShards = result->createChild("Shards");
+   for (auto& shard : shards) {
+      std::unique_lock<std::mutex> guard(shard->mutex);
+      auto xmlShard = xmlShards->createChild("Shard");
+      xmlShard->createAttribute("Index", shard->index);
+      xmlShard->createAttribute("CurrentTick", shard->currentTick);
+      xmlShard->createAttribute("TimeEvents", uint64_t(shard->eventCounter));
+      xmlShard->createAttribute("MaxTimeEvents", uint64_t(shard->maxEventCounter));
+   }
+
+   lateness.asXML(result);
+   quantumProcessing.asXML(result);
+   callbacks.asXML(result);
+
+   return result;
+}
+
 //static
-void time::TimeService::produce(time::TimeService& timeService)
+void time::TimeService::consume(TimeService& timeService, Shard& shard)
    noexcept
 {
-   microseconds timeToWait(timeService.resolution);
+   consumerShard.owner = &timeService;
+   consumerShard.index = shard.index;
+
+   if (shard.index == 0)
+      timeService.notifyEffectiveRunning();
 
-   int tickCounter = 0;
+   while (!timeService.isStopped()) {
+      uint64_t expirations;
 
-   LOG_DEBUG("TimeToWait=" << timeToWait);
+      // It will be waken up by the next tick or by the stop
+      if (read(shard.timerFd, &expirations, sizeof(expirations)) < 0) {
+         if (errno == EINTR)
+            continue;
 
-   timeService.notifyEffectiveRunning();
+         LOG_ERROR(timeService.asString() << " | Shard=" << shard.index << " | Error=" << strerror(errno));
+         break;
+      }
 
-   const microseconds usResolution(timeService.resolution);
+      if (timeService.isStopped())
+         break;
 
-   while (timeService.isRunning()) {
-      auto expectedTime = std::chrono::high_resolution_clock::now() + usResolution;
+      if (shard.index == 0 && timeService.drivesCoarseClock)
+         CoarseClock::update();
 
-      usleep(timeToWait.count());
+      // Every quantum which has been completely elapsed since the start should be processed
+      const uint64_t elapsedTicks = (std::chrono::steady_clock::now() - timeService.startTime) / timeService.resolution;
 
-      if (true) {
-         std::unique_lock <std::mutex> guard(timeService.mutex);
-         timeService.ticks.push_back(++ tickCounter);
-         timeService.condition.notify_one();
+      std::unique_lock<std::mutex> guard(shard.mutex);
+
+      while (shard.currentTick < elapsedTicks) {
+         const auto startTime = std::chrono::steady_clock::now();
+         timeService.tick(shard);
+         timeService.dispatch(shard, guard);
+         timeService.quantumProcessing.add(std::chrono::duration_cast<microseconds>(std::chrono::steady_clock::now() - startTime));
       }
-      auto deviation = expectedTime - std::chrono::high_resolution_clock::now();
-      timeToWait = timeToWait + std::chrono::duration_cast<microseconds>(deviation);
-      LOG_LOCAL7("TimeToWait=" << timeToWait);
    }
 }
 
-//static
-void time::TimeService::consume(TimeService& timeService)
+void time::TimeService::tick(Shard& shard)
    noexcept
 {
-   std::unique_lock<std::mutex> guard(timeService.mutex);
+   const uint64_t currentTick = shard.currentTick;
 
-   while (timeService.isRunning()) {
-      timeService.condition.wait(guard);
+   if ((currentTick & (FirstLevelSize - 1)) == 0)
+      cascade(shard);
 
-      while (!timeService.ticks.empty()) {
-         timeService.ticks.pop_front();
+   Quantum& timedout = shard.wheel[currentTick & (FirstLevelSize - 1)];
 
-         Quantum& timedout = timeService.timeTable[timeService.currentQuantum];
+   const milliseconds now = TimeService::now();
+   const auto steadyNow = std::chrono::steady_clock::now();
 
-         const milliseconds now = TimeService::now();
+   LOG_LOCAL7("Now=" << now << " | Shard=" << shard.index << " | CurrentTick=" << currentTick);
 
-         LOG_LOCAL7("Now=" << now << " | CurrentQuantum=" << timeService.currentQuantum);
+   while (timedout != nullptr) {
+      if (timedout->expiration > currentTick) {
+         relocate(shard, timedout);
+         continue;
+      }
 
-         for (quantum_iterator ii = timedout.begin(), maxii = timedout.end(); ii != maxii; ++ ii) {
-            std::shared_ptr<TimeEvent> timeEvent = *ii;
-            timeEvent->endTime = now;
-            LOG_DEBUG("CurrentQuantum=" << timeService.currentQuantum << " | " << timeEvent->asString());
-            timeService.events.erase(timeEvent->getId());
-            timeService.notify(*timeEvent);
+      std::shared_ptr<TimeEvent> timeEvent;
+      timeEvent.swap(timedout->self);
 
-            if (timeEvent->isPeriodical())
-               timeService.store(timeEvent, guard);
-         }
+      // It must be seen as activated all the time it is being notified
+      if (timeEvent->isPeriodical())
+         timeEvent->pending = true;
+      else
+         -- shard.eventCounter;
 
-         timedout.clear();
+      unlink(timeEvent.get());
 
-         LOG_LOCAL7("CurrentQuantum=" << timeService.currentQuantum << " has been processed");
+      timeEvent->endTime = now;
+      lateness.add(std::chrono::duration_cast<microseconds>(steadyNow - timeEvent->deadline));
+      LOG_DEBUG("Shard=" << shard.index << " | CurrentTick=" << currentTick << " | " << timeEvent->asString());
 
-         if (!timeService.temporaryQuantum.empty()) {
-            timedout.splice(timedout.end(), timeService.temporaryQuantum);
-         }
+      shard.expired.push_back(std::move(timeEvent));
+   }
+
+   LOG_LOCAL7("CurrentTick=" << currentTick << " has been processed");
+
+   ++ shard.currentTick;
+}
 
-         if (++ timeService.currentQuantum == timeService.maxQuantum) {
-            timeService.currentQuantum = 0;
+void time::TimeService::dispatch(Shard& shard, std::unique_lock<std::mutex>& guard)
+   noexcept
+{
+   if (shard.expired.empty())
+      return;
+
+   guard.unlock();
+
+   for (auto& timeEvent : shard.expired) {
+      if (timeEvent->expire())
+         deliver(timeEvent);
+   }
+
+   guard.lock();
+
+   // Periodical events keep their own pace although they were notified late
+   for (auto& timeEvent : shard.expired) {
+      if (timeEvent->pending) {
+         timeEvent->pending = false;
+
+         if (!isStopped()) {
+            timeEvent->deadline += timeEvent->getTimeout();
+            store(shard, timeEvent, timeEvent->expiration);
          }
       }
    }
+
+   shard.expired.clear();
+}
+
+void time::TimeService::deliver(const std::shared_ptr<TimeEvent>& timeEvent)
+   noexcept
+{
+   if (workers.empty()) {
+      for (auto ii = observer_begin(), maxii = observer_end(); ii != maxii; ++ ii) {
+         callback(*observer(ii), *timeEvent);
+      }
+      return;
+   }
+
+   for (auto ii = observer_begin(), maxii = observer_end(); ii != maxii; ++ ii) {
+      std::shared_ptr<basis::pattern::observer::Observer>& observer = TimeService::observer(ii);
+      Worker& worker = *workers[std::hash<std::string>()(observer->getName()) % workers.size()];
+
+      std::unique_lock<std::mutex> guard(worker.mutex);
+      worker.jobs.emplace_back(observer, timeEvent);
+      worker.condition.notify_one();
+   }
+}
+
+void time::TimeService::callback(basis::pattern::observer::Observer& observer, const TimeEvent& timeEvent)
+   noexcept
+{
+   const auto startTime = std::chrono::steady_clock::now();
+
+   notify(observer, timeEvent);
+
+   const microseconds duration = std::chrono::duration_cast<microseconds>(std::chrono::steady_clock::now() - startTime);
+
+   callbacks.add(duration);
+
+   if (duration > resolution) {
+      LOG_WARN_RATE(1, observer.getName() << " spent " << duration << " | " << timeEvent.asString());
+   }
+}
+
+//static
+void time::TimeService::work(TimeService& timeService, Worker& worker)
+   noexcept
+{
+   std::unique_lock<std::mutex> guard(worker.mutex);
+
+   while (true) {
+      worker.condition.wait(guard, [&worker]() { return worker.stopped || !worker.jobs.empty(); });
+
+      if (worker.stopped)
+         break;
+
+      Worker::Job job(std::move(worker.jobs.front()));
+      worker.jobs.pop_front();
+
+      guard.unlock();
+      timeService.callback(*job.first, *job.second);
+      guard.lock();
+   }
 }
 
 milliseconds time::TimeService::now()
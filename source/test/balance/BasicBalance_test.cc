@@ -139,3 +139,53 @@ TEST_F(ResourceListFixture, as_xml)
    }
 }
 
+
+TEST(BasicBalanceTest, snapshot_select)
+{
+   auto resourceList = ResourceListFixture::setup(100, 0);
+
+   ResourceList::Snapshot& snapshot = resourceList->getSnapshot();
+   ASSERT_EQ(100, snapshot.size());
+   ASSERT_EQ(100, snapshot.countAvailable());
+
+   for (size_t ii = 0; ii < snapshot.size(); ++ ii) {
+      TestResource::cast(snapshot.at(ii))->setAvailable(ii == 5 || ii == 70);
+   }
+
+   // The search wraps around the words of the bitmap
+   ASSERT_EQ(5, snapshot.select(71));
+   ASSERT_EQ(70, snapshot.select(6));
+   ASSERT_EQ(70, snapshot.select(70));
+   ASSERT_EQ(2, snapshot.countAvailable());
+
+   TestResource::cast(snapshot.at(99))->setAvailable(true);
+   ASSERT_EQ(5, snapshot.select(71));
+
+   resourceList->refreshAvailability();
+   ASSERT_EQ(3, snapshot.countAvailable());
+   ASSERT_EQ(99, snapshot.select(71));
+
+   for (size_t ii = 0; ii < snapshot.size(); ++ ii) {
+      TestResource::cast(snapshot.at(ii))->setAvailable(false);
+   }
+
+   ASSERT_EQ(-1, snapshot.select(0));
+   ASSERT_EQ(0, snapshot.countAvailable());
+}
+
+TEST_F(ResourceListFixture, snapshot_published_on_add)
+{
+   ResourceList::Snapshot& snapshot = resourceList->getSnapshot();
+
+   ASSERT_TRUE(resourceList->add(std::make_shared<TestResource>(MaxResources)));
+
+   // The previous snapshot keeps working for the strategies which could be using it
+   ASSERT_EQ(MaxResources, snapshot.size());
+   ASSERT_EQ(MaxResources + 1, resourceList->getSnapshot().size());
+
+   ASSERT_FALSE(resourceList->add(std::make_shared<TestResource>(0)));
+   ASSERT_EQ(MaxResources + 1, resourceList->getSnapshot().size());
+
+   // Nothing has changed since the last publication
+   ASSERT_EQ(&resourceList->getSnapshot(), &resourceList->getSnapshot());
+}
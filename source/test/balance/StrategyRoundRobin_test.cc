@@ -111,6 +111,25 @@ TEST_F(StrategyRoundRobinFixture, dont_use_unavailables)
    ASSERT_THROW(strategy.apply(RoundRobinTest::Identifier()), ResourceUnavailableException);
 }
 
+TEST_F(StrategyRoundRobinFixture, use_recovered)
+{
+   balance::StrategyRoundRobin strategy(resourceList);
+
+   ResourceList::Snapshot& snapshot = resourceList->getSnapshot();
+
+   for (size_t ii = 0; ii < snapshot.size(); ++ ii) {
+      TestResource::cast(snapshot.at(ii))->setAvailable(false);
+   }
+
+   ASSERT_THROW(strategy.apply(RoundRobinTest::Identifier()), ResourceUnavailableException);
+
+   TestResource::cast(snapshot.at(3))->setAvailable(true);
+
+   // It is checked again when there is not any available resource
+   std::shared_ptr<TestResource> myResource = TestResource::cast_copy(strategy.apply(RoundRobinTest::Identifier()));
+   ASSERT_EQ(3, myResource->getKey());
+}
+
 TEST_F(StrategyRoundRobinFixture, balance_quality)
 {
    balance::StrategyRoundRobin strategy(resourceList);
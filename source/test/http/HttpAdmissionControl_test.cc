@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <coffee/http/HttpAdmissionControl.hpp>
+#include <coffee/xml/Attribute.hpp>
+#include <coffee/xml/Node.hpp>
+
+using namespace coffee;
+
+using coffee::http::HttpAdmissionControl;
+
+TEST(HttpAdmissionControlTest, unlimited)
+{
+   auto admissionControl = HttpAdmissionControl::instantiate(HttpAdmissionControl::Unlimited, 1, HttpAdmissionControl::Unlimited);
+
+   for (int ii = 0; ii < 100; ++ ii) {
+      ASSERT_EQ(HttpAdmissionControl::Result::Accepted, admissionControl->acquire());
+   }
+
+   ASSERT_EQ(100, admissionControl->getAcceptedCounter());
+   ASSERT_EQ(100, admissionControl->getInFlight());
+}
+
+TEST(HttpAdmissionControlTest, rate_exceeded)
+{
+   auto admissionControl = HttpAdmissionControl::instantiate(1, 3, HttpAdmissionControl::Unlimited);
+
+   for (int ii = 0; ii < 3; ++ ii) {
+      ASSERT_EQ(HttpAdmissionControl::Result::Accepted, admissionControl->acquire());
+      admissionControl->release();
+   }
+
+   ASSERT_EQ(HttpAdmissionControl::Result::RateExceeded, admissionControl->acquire());
+   ASSERT_EQ(3, admissionControl->getAcceptedCounter());
+   ASSERT_EQ(1, admissionControl->getRateExceededCounter());
+   ASSERT_EQ(0, admissionControl->getInFlight());
+   ASSERT_EQ(1, admissionControl->getRetryAfter().count());
+}
+
+TEST(HttpAdmissionControlTest, retry_after)
+{
+   auto admissionControl = HttpAdmissionControl::instantiate(1, 1, HttpAdmissionControl::Unlimited);
+
+   ASSERT_EQ(HttpAdmissionControl::Result::Accepted, admissionControl->acquire());
+   ASSERT_EQ(HttpAdmissionControl::Result::RateExceeded, admissionControl->acquire());
+   ASSERT_GE(admissionControl->getRetryAfter().count(), 1);
+}
+
+TEST(HttpAdmissionControlTest, refill)
+{
+   auto admissionControl = HttpAdmissionControl::instantiate(100, 1, HttpAdmissionControl::Unlimited);
+
+   ASSERT_EQ(HttpAdmissionControl::Result::Accepted, admissionControl->acquire());
+   ASSERT_EQ(HttpAdmissionControl::Result::RateExceeded, admissionControl->acquire());
+
+   usleep(20000);
+
+   ASSERT_EQ(HttpAdmissionControl::Result::Accepted, admissionControl->acquire());
+}
+
+TEST(HttpAdmissionControlTest, concurrency_exceeded)
+{
+   auto admissionControl = HttpAdmissionControl::instantiate(HttpAdmissionControl::Unlimited, 1, 2);
+
+   ASSERT_EQ(HttpAdmissionControl::Result::Accepted, admissionControl->acquire());
+   ASSERT_EQ(HttpAdmissionControl::Result::Accepted, admissionControl->acquire());
+   ASSERT_EQ(HttpAdmissionControl::Result::ConcurrencyExceeded, admissionControl->acquire());
+
+   admissionControl->release();
+   ASSERT_EQ(HttpAdmissionControl::Result::Accepted, admissionControl->acquire());
+
+   ASSERT_EQ(3, admissionControl->getAcceptedCounter());
+   ASSERT_EQ(1, admissionControl->getConcurrencyExceededCounter());
+   ASSERT_EQ(2, admissionControl->getInFlight());
+}
+
+TEST(HttpAdmissionControlTest, bad_parameters)
+{
+   ASSERT_THROW(HttpAdmissionControl::instantiate(-1, 1, HttpAdmissionControl::Unlimited), basis::RuntimeException);
+   ASSERT_THROW(HttpAdmissionControl::instantiate(HttpAdmissionControl::Unlimited, 1, -1), basis::RuntimeException);
+}
+
+TEST(HttpAdmissionControlTest, as_xml)
+{
+   auto admissionControl = HttpAdmissionControl::instantiate(1, 1, HttpAdmissionControl::Unlimited);
+
+   admissionControl->acquire();
+   admissionControl->acquire();
+
+   auto root = std::make_shared<xml::Node>("root");
+   auto node = admissionControl->asXML(root);
+
+   auto counters = node->lookupChild("Counters");
+   ASSERT_EQ("1", counters->lookupAttribute("Accepted")->getValue());
+   ASSERT_EQ("1", counters->lookupAttribute("RateExceeded")->getValue());
+   ASSERT_EQ("0", counters->lookupAttribute("ConcurrencyExceeded")->getValue());
+}
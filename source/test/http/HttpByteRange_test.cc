@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <coffee/http/HttpByteRange.hpp>
+#include <coffee/http/HttpFileBodySource.hpp>
+#include <coffee/http/HttpRequest.hpp>
+#include <coffee/http/HttpResponse.hpp>
+
+using namespace coffee;
+
+using coffee::http::HttpByteRange;
+using coffee::http::HttpHeader;
+
+TEST(HttpByteRangeTest, satisfiable)
+{
+   HttpByteRange range;
+
+   ASSERT_EQ(HttpByteRange::Result::Satisfiable, HttpByteRange::parse("bytes=0-499", 1000, range));
+   ASSERT_EQ(0, range.getFirst());
+   ASSERT_EQ(499, range.getLast());
+   ASSERT_EQ(500, range.getLength());
+   ASSERT_EQ("bytes 0-499/1000", range.asContentRange(1000));
+
+   ASSERT_EQ(HttpByteRange::Result::Satisfiable, HttpByteRange::parse(" bytes=900-", 1000, range));
+   ASSERT_EQ(900, range.getFirst());
+   ASSERT_EQ(999, range.getLast());
+
+   ASSERT_EQ(HttpByteRange::Result::Satisfiable, HttpByteRange::parse("bytes=-100", 1000, range));
+   ASSERT_EQ(900, range.getFirst());
+   ASSERT_EQ(999, range.getLast());
+
+   ASSERT_EQ(HttpByteRange::Result::Satisfiable, HttpByteRange::parse("bytes=-5000", 1000, range));
+   ASSERT_EQ(0, range.getFirst());
+   ASSERT_EQ(999, range.getLast());
+
+   ASSERT_EQ(HttpByteRange::Result::Satisfiable, HttpByteRange::parse("bytes=500-5000", 1000, range));
+   ASSERT_EQ(500, range.getFirst());
+   ASSERT_EQ(999, range.getLast());
+}
+
+TEST(HttpByteRangeTest, not_satisfiable)
+{
+   HttpByteRange range;
+
+   ASSERT_EQ(HttpByteRange::Result::NotSatisfiable, HttpByteRange::parse("bytes=1000-", 1000, range));
+   ASSERT_EQ(HttpByteRange::Result::NotSatisfiable, HttpByteRange::parse("bytes=-0", 1000, range));
+   ASSERT_EQ(HttpByteRange::Result::NotSatisfiable, HttpByteRange::parse("bytes=0-10", 0, range));
+}
+
+TEST(HttpByteRangeTest, ignored)
+{
+   HttpByteRange range;
+
+   ASSERT_EQ(HttpByteRange::Result::Ignored, HttpByteRange::parse("items=0-10", 1000, range));
+   ASSERT_EQ(HttpByteRange::Result::Ignored, HttpByteRange::parse("bytes=10-0", 1000, range));
+   ASSERT_EQ(HttpByteRange::Result::Ignored, HttpByteRange::parse("bytes=-", 1000, range));
+   ASSERT_EQ(HttpByteRange::Result::Ignored, HttpByteRange::parse("bytes=0-10,20-30", 1000, range));
+   ASSERT_EQ(HttpByteRange::Result::Ignored, HttpByteRange::parse("bytes=a-10", 1000, range));
+}
+
+struct HttpFileBodySourceTest : ::testing::Test {
+   static const char* fileName;
+
+   void SetUp() {
+      std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+      for (int ii = 0; ii < 1000; ++ ii)
+         file << (char) ('a' + (ii % 26));
+   }
+
+   void TearDown() {
+      unlink(fileName);
+   }
+};
+
+const char* HttpFileBodySourceTest::fileName = "source/test/http/range.dat";
+
+TEST_F(HttpFileBodySourceTest, copy)
+{
+   auto source = http::HttpFileBodySource::instantiate(fileName);
+
+   ASSERT_EQ(1000, source->getSize());
+   ASSERT_TRUE(!source->getEntityTag().empty());
+
+   basis::DataBlock segment;
+   source->copy(26, 5, segment);
+   ASSERT_EQ("abcde", segment);
+
+   ASSERT_THROW(source->copy(990, 20, segment), basis::RuntimeException);
+   ASSERT_THROW(http::HttpFileBodySource::instantiate("source/test/http/non-exist.dat"), basis::RuntimeException);
+}
+
+TEST_F(HttpFileBodySourceTest, response_range)
+{
+   auto source = http::HttpFileBodySource::instantiate(fileName);
+
+   auto request = http::HttpRequest::instantiate(http::HttpRequest::Method::Get, "/file");
+   request->setHeader(HttpHeader::Type::Range, "bytes=-3");
+
+   auto response = http::HttpResponse::instantiate(request, *source);
+
+   ASSERT_EQ(206, response->getStatusCode());
+   ASSERT_EQ("bytes 997-999/1000", response->getHeaderValue(HttpHeader::Type::ContentRange));
+   ASSERT_EQ("bytes", response->getHeaderValue(HttpHeader::Type::AcceptRanges));
+   ASSERT_EQ(source->getEntityTag(), response->getHeaderValue(HttpHeader::Type::ETAG));
+   ASSERT_EQ("jkl", response->getBody());
+}
+
+TEST_F(HttpFileBodySourceTest, response_if_range)
+{
+   auto source = http::HttpFileBodySource::instantiate(fileName);
+
+   auto request = http::HttpRequest::instantiate(http::HttpRequest::Method::Get, "/file");
+   request->setHeader(HttpHeader::Type::Range, "bytes=0-9");
+
+   request->setHeader(HttpHeader::Type::IfRange, source->getEntityTag());
+   auto response = http::HttpResponse::instantiate(request, *source);
+   ASSERT_EQ(206, response->getStatusCode());
+   ASSERT_EQ(10, response->getBody().size());
+
+   request->setHeader(HttpHeader::Type::IfRange, "\"other-tag\"");
+   response = http::HttpResponse::instantiate(request, *source);
+   ASSERT_TRUE(response->isOk());
+   ASSERT_TRUE(!response->hasHeader(HttpHeader::Type::ContentRange));
+   ASSERT_EQ(1000, response->getBody().size());
+}
+
+TEST_F(HttpFileBodySourceTest, response_not_satisfiable)
+{
+   auto source = http::HttpFileBodySource::instantiate(fileName);
+
+   auto request = http::HttpRequest::instantiate(http::HttpRequest::Method::Get, "/file");
+   request->setHeader(HttpHeader::Type::Range, "bytes=2000-");
+
+   auto response = http::HttpResponse::instantiate(request, *source);
+
+   ASSERT_EQ(416, response->getStatusCode());
+   ASSERT_EQ("bytes */1000", response->getHeaderValue(HttpHeader::Type::ContentRange));
+   ASSERT_TRUE(!response->hasBody());
+}
@@ -0,0 +1,136 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <coffee/http/HttpParameters.hpp>
+#include <coffee/http/HttpRequest.hpp>
+
+using namespace coffee;
+
+using coffee::http::HttpParameters;
+
+TEST(HttpParametersTest, parse)
+{
+   const std::string buffer("name=john+smith&city=M%C3%A1laga&empty=&flag&=ignored&&name=repeated");
+
+   HttpParameters parameters;
+   parameters.parse(buffer.data(), buffer.size());
+
+   ASSERT_EQ(4, parameters.size());
+   ASSERT_EQ("john smith", parameters.getValue("name"));
+   ASSERT_EQ("M\xC3\xA1laga", parameters.getValue("city"));
+   ASSERT_TRUE(parameters.hasParameter("empty"));
+   ASSERT_TRUE(parameters.getValue("empty").empty());
+   ASSERT_TRUE(parameters.hasParameter("flag"));
+   ASSERT_TRUE(!parameters.hasParameter("ignored"));
+   ASSERT_TRUE(!parameters.hasParameter(""));
+}
+
+TEST(HttpParametersTest, not_found)
+{
+   const std::string buffer("key=value");
+
+   HttpParameters parameters;
+   parameters.parse(buffer.data(), buffer.size());
+
+   ASSERT_THROW(parameters.getValue("other"), basis::RuntimeException);
+   ASSERT_EQ("default", parameters.getValue("other", "default"));
+   ASSERT_EQ("value", parameters.getValue("key", "default"));
+}
+
+TEST(HttpParametersTest, bad_encoding)
+{
+   const std::string buffer("discount=50%&code=%zz+1");
+
+   HttpParameters parameters;
+   parameters.parse(buffer.data(), buffer.size());
+
+   ASSERT_EQ("50%", parameters.getValue("discount"));
+   ASSERT_EQ("%zz+1", parameters.getValue("code"));
+}
+
+TEST(HttpParametersTest, many_parameters)
+{
+   std::string buffer;
+
+   for (int ii = 0; ii < 1000; ++ ii) {
+      if (ii > 0)
+         buffer += '&';
+      buffer += "key" + std::to_string(ii) + "=value" + std::to_string(ii);
+   }
+
+   HttpParameters parameters;
+   parameters.parse(buffer.data(), buffer.size());
+
+   ASSERT_EQ(1000, parameters.size());
+
+   for (int ii = 0; ii < 1000; ++ ii) {
+      ASSERT_EQ("value" + std::to_string(ii), parameters.getValue("key" + std::to_string(ii)));
+   }
+}
+
+TEST(HttpParametersTest, request_query)
+{
+   auto request = http::HttpRequest::instantiate(http::HttpRequest::Method::Get, "/search?q=coffee%20beans&page=2");
+
+   ASSERT_EQ(2, request->getQueryParameters().size());
+   ASSERT_EQ("coffee beans", request->getParameter("q"));
+   ASSERT_EQ("2", request->getParameter("page"));
+   ASSERT_TRUE(!request->hasParameter("other"));
+   ASSERT_THROW(request->getParameter("other"), basis::RuntimeException);
+}
+
+TEST(HttpParametersTest, request_form)
+{
+   auto request = http::HttpRequest::instantiate(http::HttpRequest::Method::Put, "/order?id=123");
+
+   request->setBody("item=espresso&quantity=2");
+   ASSERT_TRUE(request->getFormParameters().empty());
+   ASSERT_TRUE(!request->hasParameter("item"));
+
+   request->setHeader(http::HttpHeader::Type::ContentType, "application/x-www-form-urlencoded; charset=UTF-8");
+   request->setBody("item=espresso&quantity=2&id=456");
+
+   ASSERT_EQ(3, request->getFormParameters().size());
+   ASSERT_EQ("espresso", request->getParameter("item"));
+   ASSERT_EQ("2", request->getParameter("quantity"));
+   ASSERT_EQ("123", request->getParameter("id"));
+
+   request->setBody("item=latte");
+   ASSERT_EQ("latte", request->getParameter("item"));
+   ASSERT_TRUE(!request->hasParameter("quantity"));
+}
+
+TEST(HttpParametersTest, request_form_header_after_access)
+{
+   auto request = http::HttpRequest::instantiate(http::HttpRequest::Method::Put, "/order");
+
+   request->setBody("item=espresso&quantity=2");
+   ASSERT_TRUE(!request->hasParameter("item"));
+
+   // The body is not modified again
+   request->setHeader(http::HttpHeader::Type::ContentType, "application/x-www-form-urlencoded");
+   ASSERT_EQ(2, request->getFormParameters().size());
+   ASSERT_EQ("espresso", request->getParameter("item"));
+}
@@ -26,6 +26,7 @@
 #include <csignal>
 
 #include <coffee/app/ApplicationServiceStarter.hpp>
+#include <coffee/http/HttpAdmissionControl.hpp>
 #include <coffee/http/HttpClient.hpp>
 #include <coffee/http/HttpRequest.hpp>
 #include <coffee/http/HttpResponse.hpp>
@@ -233,6 +234,35 @@ TEST_F(HttpServiceFixtureTest, http_service_fails)
    ASSERT_EQ("This operation failed", response->getErrorDescription());
 }
 
+TEST_F(HttpServiceFixtureTest, http_service_admission_control)
+{
+   auto admissionControl = http::HttpAdmissionControl::instantiate(1, 1, http::HttpAdmissionControl::Unlimited);
+
+   ASSERT_THROW(httpService->setAdmissionControl("/non-exist", admissionControl), basis::RuntimeException);
+   ASSERT_NO_THROW(httpService->setAdmissionControl("/echo", admissionControl));
+
+   {
+      auto request = http::HttpRequest::instantiate(http::HttpRequest::Method::Get, "/echo");
+      request->setBody("first");
+      auto response = httpClient->send(request);
+      ASSERT_TRUE(response->isOk());
+      ASSERT_EQ("first", response->getBody());
+   }
+
+   {
+      auto request = http::HttpRequest::instantiate(http::HttpRequest::Method::Get, "/echo");
+      request->setBody("second");
+      auto response = httpClient->send(request);
+      ASSERT_EQ(503, response->getStatusCode());
+      ASSERT_TRUE(!response->hasBody());
+      ASSERT_TRUE(response->hasHeader(http::HttpHeader::Type::RetryAfter));
+   }
+
+   ASSERT_EQ(1, admissionControl->getAcceptedCounter());
+   ASSERT_EQ(1, admissionControl->getRateExceededCounter());
+   ASSERT_EQ(0, admissionControl->getInFlight());
+}
+
 TEST_F(HttpServiceFixtureTest, http_service_no_http) {
    networking::SocketArguments arguments;
    auto clientSocket = networkingService->createClientSocket(arguments.addEndPoint("tcp://localhost:5555"));
@@ -93,3 +93,21 @@ TEST(HttpUrlBuilder, repeat_component)
 
    ASSERT_THROW(builder.setCompoment(ComponentName::Port, "444"), basis::RuntimeException);
 }
+
+TEST(HttpUrlBuilder, encode_query)
+{
+   http::url::URLBuilder builder;
+
+   builder.setCompoment(ComponentName::Scheme, "http");
+   builder.setCompoment(ComponentName::Host, "localhost");
+   builder.setCompoment(ComponentName::Path, "/search");
+   builder.addKeyValue("text", "one&two = three").addKeyValue("plus", "1+1");
+
+   auto url = builder.build();
+
+   ASSERT_EQ("http://localhost/search?text=one%26two%20%3D%20three&plus=1%2B1", url->encode());
+
+   auto ii = url->query_begin();
+   ASSERT_EQ("one&two = three", URL::keyValue(ii).second);
+   ASSERT_EQ("1+1", URL::keyValue(++ ii).second);
+}
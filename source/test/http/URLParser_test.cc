@@ -353,3 +353,59 @@ TEST(HttpUrlParserTest, no_numeric_port)
    http::url::URLParser parser("tcp://host.com:123a");
    ASSERT_THROW(parser.build(), basis::RuntimeException);
 }
+
+TEST(HttpUrlParserTest, delimiters_order)
+{
+   const char* expression = "tcp://localhost.me:8080?next=/path/resource#fragment";
+
+   http::url::URLParser parser(expression);
+   auto url = parser.build();
+
+   ASSERT_EQ("localhost.me", url->getComponent(ComponentName::Host));
+   ASSERT_EQ("8080", url->getComponent(ComponentName::Port));
+   ASSERT_TRUE(!url->hasComponent(ComponentName::Path));
+   ASSERT_EQ("#fragment", url->getComponent(ComponentName::Fragment));
+
+   auto keyValue = URL::keyValue(url->query_begin());
+   ASSERT_EQ("next", keyValue.first);
+   ASSERT_EQ("/path/resource", keyValue.second);
+
+   ASSERT_EQ(expression, url->encode());
+}
+
+TEST(HttpUrlParserTest, percent_decoding)
+{
+   const char* expression = "/search?q=caf%C3%A9+con%20leche&a%26b=1%3D2&&empty";
+
+   http::url::URLParser parser(expression);
+   auto url = parser.build();
+
+   auto ii = url->query_begin();
+   auto keyValue = URL::keyValue(ii);
+   ASSERT_EQ("q", keyValue.first);
+   ASSERT_EQ("caf\xC3\xA9 con leche", keyValue.second);
+
+   keyValue = URL::keyValue(++ ii);
+   ASSERT_EQ("a&b", keyValue.first);
+   ASSERT_EQ("1=2", keyValue.second);
+
+   keyValue = URL::keyValue(++ ii);
+   ASSERT_EQ("empty", keyValue.first);
+   ASSERT_TRUE(keyValue.second.empty());
+
+   ASSERT_TRUE(++ ii == url->query_end());
+
+   ASSERT_EQ(expression, url->encode());
+}
+
+TEST(HttpUrlParserTest, bad_percent_encoding)
+{
+   {
+      http::url::URLParser parser("/search?q=100%");
+      ASSERT_THROW(parser.build(), basis::RuntimeException);
+   }
+   {
+      http::url::URLParser parser("/search?q=%G1");
+      ASSERT_THROW(parser.build(), basis::RuntimeException);
+   }
+}
@@ -0,0 +1,157 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <coffee/logger/AsyncWriter.hpp>
+#include <coffee/logger/Formatter.hpp>
+#include <coffee/logger/Logger.hpp>
+#include <coffee/logger/UnlimitedTraceWriter.hpp>
+
+#include "TestWriter.hpp"
+
+using namespace coffee;
+using namespace coffee::logger;
+using coffee::test::logger::MessageFormatter;
+
+namespace {
+
+class SlowWriter : public Writer {
+public:
+   SlowWriter() : Writer("SlowWriter"), m_lines(0), m_batches(0) {;}
+
+   unsigned int getLines() const noexcept { return m_lines; }
+   unsigned int getBatches() const noexcept { return m_batches; }
+
+   std::mutex gate;
+
+private:
+   std::atomic<unsigned int> m_lines;
+   std::atomic<unsigned int> m_batches;
+
+   void initialize() throw(basis::RuntimeException) {;}
+   void apply(const Level::_v level, const std::string& line) noexcept {
+      std::lock_guard<std::mutex> guard(gate);
+      ++ m_lines;
+   }
+   void applyBatch(const Line* lines, const size_t size) noexcept {
+      ++ m_batches;
+      Writer::applyBatch(lines, size);
+   }
+};
+
+}
+
+TEST(AsyncWriterTest, many_producers)
+{
+   auto target = std::make_shared<SlowWriter>();
+   auto writer = AsyncWriter::instantiate(target, 1024, AsyncWriter::OverflowPolicy::Block);
+
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+   Logger::setLevel(Level::Debug);
+
+   const int threadCounter = 4;
+   const int linesByThread = 5000;
+   std::vector<std::thread> threads;
+
+   for (int ii = 0; ii < threadCounter; ++ ii) {
+      threads.push_back(std::thread([linesByThread]() {
+         for (int jj = 0; jj < linesByThread; ++ jj)
+            LOG_DEBUG("line " << jj);
+      }));
+   }
+
+   for (auto& thread : threads)
+      thread.join();
+
+   writer->flush();
+
+   ASSERT_EQ(threadCounter * linesByThread, target->getLines());
+   ASSERT_EQ(threadCounter * linesByThread, writer->getWrittenCounter());
+   ASSERT_EQ(0, writer->getDroppedCounter());
+   ASSERT_LT(target->getBatches(), target->getLines());
+}
+
+TEST(AsyncWriterTest, drop_when_full)
+{
+   auto target = std::make_shared<SlowWriter>();
+   auto writer = AsyncWriter::instantiate(target, 10, AsyncWriter::OverflowPolicy::Drop);
+
+   ASSERT_EQ(AsyncWriter::MinimalCapacity, writer->getCapacity());
+
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+   Logger::setLevel(Level::Debug);
+
+   const int lines = AsyncWriter::MinimalCapacity * 4;
+
+   {
+      // The consumer will be stopped on the first line, so the ring will be filled up
+      std::lock_guard<std::mutex> guard(target->gate);
+      for (int ii = 0; ii < lines; ++ ii)
+         LOG_DEBUG("line " << ii);
+   }
+
+   writer->flush();
+
+   ASSERT_GT(writer->getDroppedCounter(), 0);
+   ASSERT_EQ(lines, writer->getDroppedCounter() + writer->getWrittenCounter());
+   ASSERT_EQ(writer->getWrittenCounter(), target->getLines());
+}
+
+TEST(AsyncWriterTest, write_file)
+{
+   const char* fileName = "async-trace.log";
+   unlink(fileName);
+
+   {
+      auto writer = AsyncWriter::instantiate(std::make_shared<UnlimitedTraceWriter>(fileName), 256, AsyncWriter::OverflowPolicy::Block);
+      Logger::initialize(writer, std::make_shared<MessageFormatter>());
+      Logger::setLevel(Level::Debug);
+
+      for (int ii = 0; ii < 1000; ++ ii)
+         LOG_DEBUG("line " << ii);
+
+      writer->flush();
+
+      // Releases the writer and its thread
+      Logger::initialize(std::make_shared<SlowWriter>(), std::make_shared<MessageFormatter>());
+   }
+
+   std::ifstream file(fileName);
+   std::string line;
+   int counter = 0;
+
+   while (std::getline(file, line)) {
+      ASSERT_EQ("line " + std::to_string(counter), line);
+      ++ counter;
+   }
+
+   ASSERT_EQ(1000, counter);
+   unlink(fileName);
+}
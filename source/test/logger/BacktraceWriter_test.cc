@@ -25,6 +25,8 @@
 
 #include <iostream>
 #include <chrono>
+#include <fstream>
+#include <thread>
 
 #include <coffee/basis/AsString.hpp>
 
@@ -121,6 +123,62 @@ TEST_F(BacktrakingTraceTest, change_level_test)
    ASSERT_EQ(backtrackingLength + 1, writer->getLineNo());
 }
 
+TEST_F(BacktrakingTraceTest, merge_threads)
+{
+   // Each thread keeps its own history, the newest lines of every one are merged by time
+   std::thread first([]() {
+      for(int ii = 0; ii < backtrackingLength; ++ ii)
+         LOG_DEBUG("first thread " << ii);
+   });
+   first.join();
+
+   std::thread second([]() {
+      LOG_DEBUG("second thread 0");
+      LOG_DEBUG("second thread 1");
+   });
+   second.join();
+
+   LOG_ERROR("This is the error");
+
+   ASSERT_EQ(backtrackingLength + 1, writer->getLineNo());
+
+   std::ifstream input("backtrace.log");
+   std::vector<std::string> lines;
+   std::string line;
+   while (std::getline(input, line))
+      lines.push_back(line);
+
+   ASSERT_EQ(backtrackingLength + 1, lines.size());
+   ASSERT_NE(std::string::npos, lines[0].find("first thread 2"));
+   ASSERT_NE(std::string::npos, lines[2].find("first thread 4"));
+   ASSERT_NE(std::string::npos, lines[3].find("second thread 0"));
+   ASSERT_NE(std::string::npos, lines[4].find("second thread 1"));
+   ASSERT_NE(std::string::npos, lines[5].find("This is the error"));
+
+   // Histories were emptied by the backtrace
+   LOG_ERROR("other error");
+   ASSERT_EQ(backtrackingLength + 2, writer->getLineNo());
+}
+
+TEST_F(BacktrakingTraceTest, several_writers)
+{
+   unlink("backtrace2.log");
+
+   // Both writers receive every line from the same thread, each one keeps its own history
+   auto other = std::make_shared<BacktraceWriter>("backtrace2.log", 256, backtrackingLength - 2);
+   Logger::add(other);
+
+   for(int ii = 0; ii < backtrackingLength * 2; ++ ii)
+      LOG_DEBUG("this is the line number " << ii);
+
+   LOG_ERROR("This is the error");
+
+   ASSERT_EQ(backtrackingLength + 1, writer->getLineNo());
+   ASSERT_EQ(backtrackingLength - 1, other->getLineNo());
+
+   unlink("backtrace2.log");
+}
+
 TEST_F(BacktrakingTraceTest, performance_measure_test)
 {
    Logger::setLevel(Level::Error);
@@ -28,6 +28,7 @@
 #include <coffee/logger/DefaultFormatter.hpp>
 
 #include <iostream>
+#include <regex>
 
 using namespace coffee;
 
@@ -47,6 +48,18 @@ private:
    void initialize () throw (basis::RuntimeException) {;}
 };
 
+class LastLineWriter : public logger::Writer {
+public:
+   LastLineWriter () : logger::Writer ("LastLineWriter") {;}
+
+   const std::string& getLastLine () const throw () { return m_lastLine; }
+
+private:
+   std::string m_lastLine;
+
+   void apply (const logger::Level::_v level, const std::string& line) throw () { m_lastLine = line; }
+   void initialize () throw (basis::RuntimeException) {;}
+};
 
 TEST( DefaultFormatter, basic)
 {
@@ -64,3 +77,21 @@ TEST( DefaultFormatter, basic)
    ASSERT_EQ(logger::Level::Local2 + 1, writer->getCounter ());
 }
 
+
+TEST( DefaultFormatter, precision)
+{
+   auto writer = std::make_shared<LastLineWriter>();
+
+   logger::Logger::initialize(writer, logger::DefaultFormatter::instantiate());
+   LOG_ERROR("seconds");
+   ASSERT_TRUE(std::regex_search(writer->getLastLine(), std::regex("^\\[[0-9]{2}/[0-9]{2}/[0-9]{4} [0-9]{2}:[0-9]{2}:[0-9]{2}\\] ")));
+
+   logger::Logger::initialize(writer, logger::DefaultFormatter::instantiate(logger::DefaultFormatter::Precision::Milliseconds));
+   LOG_ERROR("milliseconds");
+   ASSERT_TRUE(std::regex_search(writer->getLastLine(), std::regex("^\\[[0-9]{2}/[0-9]{2}/[0-9]{4} [0-9]{2}:[0-9]{2}:[0-9]{2}\\.[0-9]{3}\\] ")));
+
+   logger::Logger::initialize(writer, logger::DefaultFormatter::instantiate(logger::DefaultFormatter::Precision::Microseconds));
+   LOG_ERROR("microseconds");
+   ASSERT_TRUE(std::regex_search(writer->getLastLine(), std::regex("^\\[[0-9]{2}/[0-9]{2}/[0-9]{4} [0-9]{2}:[0-9]{2}:[0-9]{2}\\.[0-9]{6}\\] ")));
+   ASSERT_NE(std::string::npos, writer->getLastLine().find("microseconds"));
+}
@@ -0,0 +1,152 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <regex>
+
+#include <coffee/logger/DefaultFormatter.hpp>
+#include <coffee/logger/Fields.hpp>
+#include <coffee/logger/JsonFormatter.hpp>
+#include <coffee/logger/Logger.hpp>
+#include <coffee/logger/Writer.hpp>
+
+using namespace coffee;
+using namespace coffee::logger;
+
+namespace {
+
+class LastLineWriter : public Writer {
+public:
+   LastLineWriter() : Writer("LastLineWriter") {;}
+
+   const std::string& getLastLine() const noexcept { return m_lastLine; }
+
+private:
+   std::string m_lastLine;
+
+   void initialize() throw(basis::RuntimeException) {;}
+   void apply(const Level::_v level, const std::string& line) noexcept { m_lastLine = line; }
+};
+
+class NestedWriter : public Writer {
+public:
+   NestedWriter() : Writer("NestedWriter"), m_writing(false) {;}
+
+private:
+   bool m_writing;
+
+   void initialize() throw(basis::RuntimeException) {;}
+   void apply(const Level::_v level, const std::string& line) noexcept {
+      if (m_writing)
+         return;
+      m_writing = true;
+      LOG_INFO("nested trace");
+      m_writing = false;
+   }
+};
+
+}
+
+struct JsonFormatterFixture : public ::testing::Test {
+   JsonFormatterFixture() : writer(std::make_shared<LastLineWriter>()) {
+      Logger::initialize(writer, JsonFormatter::instantiate());
+      Logger::setLevel(Level::Debug);
+   }
+
+   std::shared_ptr<LastLineWriter> writer;
+};
+
+TEST_F(JsonFormatterFixture, without_fields)
+{
+   LOG_INFO("value=" << 10);
+
+   const std::string& line = writer->getLastLine();
+
+   ASSERT_TRUE(std::regex_search(line, std::regex("^\\{\"timestamp\":\"[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}:[0-9]{2}\\.[0-9]{3}Z\",")));
+   ASSERT_NE(std::string::npos, line.find("\"level\":\"Information\",\"thread\":\"0x"));
+   ASSERT_NE(std::string::npos, line.find("test/logger/JsonFormatter_test.cc\",\"line\":"));
+   ASSERT_NE(std::string::npos, line.find("\"message\":\"value=10\"}"));
+   ASSERT_EQ(std::string::npos, line.find("\"fields\""));
+}
+
+TEST_F(JsonFormatterFixture, typed_fields)
+{
+   const std::string path("/some/path");
+   basis::StreamString reason("missing");
+
+   LOG_WARN_FIELDS(("path", path)("status", 404)("ratio", 0.5)("cached", false)("size", 7U)("reason", reason)("level", Level::Error), "Servlet not found");
+
+   const std::string& line = writer->getLastLine();
+
+   ASSERT_NE(std::string::npos, line.find("\"message\":\"Servlet not found\",\"fields\":{\"path\":\"/some/path\",\"status\":404,\"ratio\":0.5,\"cached\":false,\"size\":7,\"reason\":\"missing\",\"level\":3}}"));
+}
+
+TEST_F(JsonFormatterFixture, escape_strings)
+{
+   LOG_ERROR_FIELDS(("text", "tab\tquote\"back\\slash\x01"), "line\nbreak");
+
+   const std::string& line = writer->getLastLine();
+
+   ASSERT_NE(std::string::npos, line.find("\"message\":\"line\\nbreak\""));
+   ASSERT_NE(std::string::npos, line.find("\"text\":\"tab\\tquote\\\"back\\\\slash\\u0001\""));
+}
+
+TEST_F(JsonFormatterFixture, max_fields)
+{
+   Fields fields;
+
+   for (int ii = 0; ii < Fields::MaxSize + 5; ++ ii)
+      fields("name", ii);
+
+   ASSERT_EQ(Fields::MaxSize, fields.size());
+   ASSERT_EQ(Fields::MaxSize - 1, (fields.end() - 1)->integer);
+}
+
+TEST_F(JsonFormatterFixture, fields_on_default_formatter)
+{
+   Logger::initialize(writer, DefaultFormatter::instantiate());
+
+   LOG_ERROR_FIELDS(("path", "/x")("status", 404), "Servlet not found");
+   ASSERT_NE(std::string::npos, writer->getLastLine().find("Servlet not found | path=/x status=404"));
+
+   // The fields only belong to the trace which received them
+   LOG_ERROR("Other trace");
+   ASSERT_EQ(std::string::npos, writer->getLastLine().find("path="));
+   ASSERT_EQ(nullptr, Fields::getCurrent());
+
+   Logger::write(Level::Error, basis::StreamString("Without fields"), Fields(), COFFEE_LOG_LOCATION);
+   const std::string& line = writer->getLastLine();
+   ASSERT_EQ("Without fields", line.substr(line.size() - 14));
+}
+
+TEST_F(JsonFormatterFixture, nested_trace)
+{
+   // The first writer traces while the line is being written, the second one receives both of them
+   Logger::initialize(std::make_shared<NestedWriter>(), JsonFormatter::instantiate());
+   Logger::add(writer);
+
+   LOG_INFO("outer trace");
+
+   ASSERT_NE(std::string::npos, writer->getLastLine().find("\"message\":\"outer trace\""));
+}
@@ -0,0 +1,173 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <coffee/logger/Formatter.hpp>
+#include <coffee/logger/Logger.hpp>
+#include <coffee/logger/MmapCircularTraceWriter.hpp>
+
+#include "TestWriter.hpp"
+
+using namespace coffee;
+using namespace coffee::logger;
+using coffee::test::logger::MessageFormatter;
+
+namespace {
+
+std::vector<std::string> split(const std::string& content) {
+   std::vector<std::string> result;
+   std::istringstream stream(content);
+   std::string line;
+
+   while (std::getline(stream, line))
+      result.push_back(line);
+
+   return result;
+}
+
+}
+
+struct MmapCircularTraceWriterFixture : public ::testing::Test {
+   MmapCircularTraceWriterFixture() {
+      unlink(fileName);
+      Logger::setLevel(Level::Debug);
+   }
+   ~MmapCircularTraceWriterFixture() {
+      Logger::initialize(std::make_shared<MmapCircularTraceWriter>(otherFileName, 64), std::make_shared<MessageFormatter>());
+      unlink(fileName);
+      unlink(otherFileName);
+   }
+
+   static const char* fileName;
+   static const char* otherFileName;
+};
+
+const char* MmapCircularTraceWriterFixture::fileName = "trace.mmap";
+const char* MmapCircularTraceWriterFixture::otherFileName = "other-trace.mmap";
+
+TEST_F(MmapCircularTraceWriterFixture, extract_lines)
+{
+   auto writer = MmapCircularTraceWriter::instantiate(fileName, 64);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+
+   ASSERT_TRUE(writer->isMapped());
+   ASSERT_EQ(64 * 1024, writer->getKbytesMaxSize());
+
+   for (int ii = 0; ii < 100; ++ ii) {
+      LOG_DEBUG("line " << ii);
+   }
+
+   auto lines = split(MmapCircularTraceWriter::extract(fileName));
+   ASSERT_EQ(100, lines.size());
+   for (int ii = 0; ii < 100; ++ ii) {
+      ASSERT_EQ("line " + std::to_string(ii), lines[ii]);
+   }
+   ASSERT_EQ(0, writer->getLoops());
+}
+
+TEST_F(MmapCircularTraceWriterFixture, overwrite_oldest_lines)
+{
+   auto writer = MmapCircularTraceWriter::instantiate(fileName, 64);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+
+   const std::string padding(100, 'x');
+   const int maxLine = 2000;
+
+   for (int ii = 0; ii < maxLine; ++ ii) {
+      LOG_DEBUG(ii << " " << padding);
+   }
+
+   ASSERT_EQ(3, writer->getLoops());
+
+   const std::string content = MmapCircularTraceWriter::extract(fileName);
+   ASSERT_TRUE(content.size() <= writer->getKbytesMaxSize());
+
+   auto lines = split(content);
+   ASSERT_TRUE(lines.size() > 500);
+
+   const int first = maxLine - lines.size();
+   for (size_t ii = 0; ii < lines.size(); ++ ii) {
+      ASSERT_EQ(std::to_string(first + ii) + " " + padding, lines[ii]);
+   }
+}
+
+TEST_F(MmapCircularTraceWriterFixture, reuse_file)
+{
+   auto writer = MmapCircularTraceWriter::instantiate(fileName, 64);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+   LOG_DEBUG("before restart");
+
+   writer = MmapCircularTraceWriter::instantiate(fileName, 64);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+   LOG_DEBUG("after restart");
+
+   auto lines = split(MmapCircularTraceWriter::extract(fileName));
+   ASSERT_EQ(2, lines.size());
+   ASSERT_EQ("before restart", lines[0]);
+   ASSERT_EQ("after restart", lines[1]);
+
+   // Other size discards the previous content
+   writer = MmapCircularTraceWriter::instantiate(fileName, 128);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+   LOG_DEBUG("new size");
+
+   lines = split(MmapCircularTraceWriter::extract(fileName));
+   ASSERT_EQ(1, lines.size());
+   ASSERT_EQ("new size", lines[0]);
+}
+
+TEST_F(MmapCircularTraceWriterFixture, survive_crash)
+{
+   const pid_t child = fork();
+   ASSERT_NE(-1, child);
+
+   if (child == 0) {
+      auto writer = MmapCircularTraceWriter::instantiate(fileName, 64);
+      Logger::initialize(writer, std::make_shared<MessageFormatter>());
+      LOG_DEBUG("last words");
+      abort();
+   }
+
+   int status;
+   ASSERT_EQ(child, waitpid(child, &status, 0));
+   ASSERT_TRUE(WIFSIGNALED(status));
+
+   auto lines = split(MmapCircularTraceWriter::extract(fileName));
+   ASSERT_EQ(1, lines.size());
+   ASSERT_EQ("last words", lines[0]);
+}
+
+TEST_F(MmapCircularTraceWriterFixture, can_not_map)
+{
+   auto writer = MmapCircularTraceWriter::instantiate("/does/not/exist/trace.mmap", 64);
+
+   ASSERT_THROW(Logger::initialize(writer), basis::RuntimeException);
+   ASSERT_FALSE(writer->isMapped());
+   ASSERT_THROW(MmapCircularTraceWriter::extract("/does/not/exist/trace.mmap"), basis::RuntimeException);
+}
@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+#include <coffee/logger/AsyncWriter.hpp>
+#include <coffee/logger/Formatter.hpp>
+#include <coffee/logger/Logger.hpp>
+#include <coffee/logger/Record.hpp>
+
+#include "TestWriter.hpp"
+
+using namespace coffee;
+using namespace coffee::logger;
+using coffee::test::logger::MessageFormatter;
+using coffee::test::logger::LinesWriter;
+
+namespace {
+
+std::string decode(const Record& record, Record::Header& header) {
+   basis::StreamString message;
+   if (!Record::decode(record.getData().data(), record.getData().size(), header, message))
+      return "<invalid>";
+   return message;
+}
+
+}
+
+TEST(RecordTest, encode_values)
+{
+   static const RecordSite site(Level::Debug, "int={} neg={} unsigned={} real={} bool={} char={} text={} string={}", COFFEE_LOG_LOCATION);
+
+   Record record;
+   record.encode(site, 10, -5, 7U, 1.5, true, 'x', "literal", std::string("string"));
+
+   Record::Header header;
+   ASSERT_EQ("int=10 neg=-5 unsigned=7 real=1.500000e+00 bool=true char=x text=literal string=string", decode(record, header));
+   ASSERT_EQ(&site, header.site);
+   ASSERT_TRUE(pthread_equal(pthread_self(), header.thread));
+   ASSERT_TRUE(std::chrono::system_clock::now() - header.timestamp < std::chrono::seconds(5));
+   ASSERT_EQ(&site, RecordSite::find(site.getId()));
+}
+
+TEST(RecordTest, placeholders_mismatch)
+{
+   static const RecordSite site(Level::Debug, "first={} second={}", COFFEE_LOG_LOCATION);
+
+   Record record;
+   Record::Header header;
+
+   record.encode(site, 1);
+   ASSERT_EQ("first=1 second={}", decode(record, header));
+
+   record.encode(site, 1, 2, 3, "four");
+   ASSERT_EQ("first=1 second=2 3 four", decode(record, header));
+}
+
+TEST(RecordTest, invalid_data)
+{
+   static const RecordSite site(Level::Debug, "value={}", COFFEE_LOG_LOCATION);
+
+   Record record;
+   record.encode(site, "text");
+
+   const std::string& data = record.getData();
+   Record::Header header;
+   basis::StreamString message;
+
+   ASSERT_FALSE(Record::decode(data.data(), 3, header, message));
+   ASSERT_FALSE(Record::decode(data.data(), data.size() - 1, header, message));
+}
+
+TEST(RecordTest, immediate_writer)
+{
+   auto writer = std::make_shared<LinesWriter>();
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+   Logger::setLevel(Level::Information);
+
+   LOG_RECORD(Level::Debug, "filtered {}", 0);
+   LOG_RECORD(Level::Information, "value {} of {}", 1, "one");
+   LOG_RECORD(Level::Warning, "without values");
+
+   auto lines = writer->getLines();
+   ASSERT_EQ(2, lines.size());
+   ASSERT_EQ("value 1 of one", lines[0]);
+   ASSERT_EQ("without values", lines[1]);
+}
+
+TEST(RecordTest, deferred_writer)
+{
+   auto target = std::make_shared<LinesWriter>();
+   auto writer = AsyncWriter::instantiate(target, 128, AsyncWriter::OverflowPolicy::Block);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+   Logger::setLevel(Level::Debug);
+
+   for (int ii = 0; ii < 500; ++ ii) {
+      if (ii % 2)
+         LOG_RECORD(Level::Debug, "record {}", ii)
+      else
+         LOG_DEBUG("line " << ii);
+   }
+
+   writer->flush();
+
+   auto lines = target->getLines();
+   ASSERT_EQ(500, lines.size());
+   for (int ii = 0; ii < 500; ++ ii) {
+      ASSERT_EQ(((ii % 2) ? "record ": "line ") + std::to_string(ii), lines[ii]);
+   }
+}
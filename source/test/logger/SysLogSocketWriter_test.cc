@@ -0,0 +1,171 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <coffee/logger/AsyncWriter.hpp>
+#include <coffee/logger/Formatter.hpp>
+#include <coffee/logger/Logger.hpp>
+#include <coffee/logger/SysLogSocketWriter.hpp>
+
+#include "TestWriter.hpp"
+
+using namespace coffee;
+using namespace coffee::logger;
+using coffee::test::logger::MessageFormatter;
+
+// Plays the role of the syslog daemon
+struct SysLogSocketWriterFixture : public ::testing::Test {
+   static const char* path;
+
+   SysLogSocketWriterFixture() : server(-1) {
+      bind();
+      Logger::setLevel(Level::Debug);
+   }
+
+   ~SysLogSocketWriterFixture() {
+      close();
+   }
+
+   void bind() {
+      unlink(path);
+      server = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+      sockaddr_un address;
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      strcpy(address.sun_path, path);
+      ASSERT_EQ(0, ::bind(server, (sockaddr*) &address, sizeof(address)));
+   }
+
+   void close() {
+      if (server != -1)
+         ::close(server);
+      server = -1;
+      unlink(path);
+   }
+
+   std::vector<std::string> receive() {
+      std::vector<std::string> result;
+      char buffer[16 * 1024];
+      ssize_t size;
+
+      while ((size = recv(server, buffer, sizeof(buffer), 0)) > 0) {
+         result.push_back(std::string(buffer, size));
+      }
+
+      return result;
+   }
+
+   int server;
+};
+
+const char* SysLogSocketWriterFixture::path = "syslog-test.sock";
+
+TEST_F(SysLogSocketWriterFixture, send_datagrams)
+{
+   auto writer = SysLogSocketWriter::instantiate("coffee", path);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+   Logger::setLevel(Level::Local7);
+
+   LOG_ERROR("error line");
+   LOG_DEBUG("debug line");
+   Logger::write(Level::Local3, "local line", COFFEE_FILE_LOCATION);
+
+   const std::string tag = "coffee[" + std::to_string(getpid()) + "]: ";
+
+   auto messages = receive();
+   ASSERT_EQ(3, messages.size());
+   ASSERT_EQ("<11>" + tag + "error line", messages[0]);
+   ASSERT_EQ("<15>" + tag + "debug line", messages[1]);
+   ASSERT_EQ("<15>" + tag + "local line", messages[2]);
+   ASSERT_EQ(3, writer->getSentCounter());
+   ASSERT_EQ(0, writer->getDroppedCounter());
+}
+
+TEST_F(SysLogSocketWriterFixture, batches)
+{
+   auto target = SysLogSocketWriter::instantiate("coffee", path, 16 << 3);
+   auto writer = AsyncWriter::instantiate(target, 1024, AsyncWriter::OverflowPolicy::Block);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+
+   // Linux only queues net.unix.max_dgram_qlen datagrams (10 by default) till the receiver reads them
+   for (int ii = 0; ii < 10; ++ ii) {
+      LOG_WARN("line " << ii);
+   }
+
+   writer->flush();
+
+   auto messages = receive();
+   ASSERT_EQ(10, messages.size());
+   ASSERT_EQ("<132>coffee[" + std::to_string(getpid()) + "]: line 9", messages[9]);
+   ASSERT_EQ(10, target->getSentCounter());
+}
+
+TEST_F(SysLogSocketWriterFixture, drop_when_full)
+{
+   auto writer = SysLogSocketWriter::instantiate("coffee", path);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+
+   const std::string padding(1024, 'x');
+   const int maxLine = 10000;
+
+   // Nobody reads the socket, so the calls must not block
+   for (int ii = 0; ii < maxLine; ++ ii) {
+      LOG_WARN(ii << padding);
+   }
+
+   ASSERT_LT(0, writer->getDroppedCounter());
+   ASSERT_EQ(maxLine, writer->getSentCounter() + writer->getDroppedCounter());
+   ASSERT_EQ(writer->getSentCounter(), receive().size());
+}
+
+TEST_F(SysLogSocketWriterFixture, reconnect)
+{
+   auto writer = SysLogSocketWriter::instantiate("coffee", path);
+   Logger::initialize(writer, std::make_shared<MessageFormatter>());
+
+   LOG_ERROR("first");
+   ASSERT_EQ(1, receive().size());
+
+   // The syslog daemon is restarted
+   close();
+   bind();
+
+   LOG_ERROR("second");
+   auto messages = receive();
+   ASSERT_EQ(1, messages.size());
+   ASSERT_NE(std::string::npos, messages[0].find("second"));
+}
+
+TEST(SysLogSocketWriterTest, can_not_connect)
+{
+   auto writer = std::make_shared<SysLogSocketWriter>("coffee", "/does/not/exist");
+
+   ASSERT_THROW(Logger::initialize(writer), basis::RuntimeException);
+   ASSERT_EQ(SysLogSocketWriter::NullStream, writer->getStream());
+}
@@ -0,0 +1,80 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef _coffee_test_logger_TestWriter_hpp
+#define _coffee_test_logger_TestWriter_hpp
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <coffee/logger/Formatter.hpp>
+#include <coffee/logger/Writer.hpp>
+
+namespace coffee {
+
+namespace test {
+
+namespace logger {
+
+/**
+ * Formatter which only keeps the message of the trace.
+ */
+class MessageFormatter : public coffee::logger::Formatter {
+public:
+   MessageFormatter() {;}
+
+private:
+   std::string apply(const coffee::logger::Level::_v level, const basis::StreamString& comment, const char* methodName, const char* file, const unsigned lineno) noexcept {
+      return comment;
+   }
+};
+
+/**
+ * Writer which keeps in memory every line received.
+ */
+class LinesWriter : public coffee::logger::Writer {
+public:
+   LinesWriter() : Writer("LinesWriter") {;}
+
+   std::vector<std::string> getLines() noexcept {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      return m_lines;
+   }
+
+private:
+   std::mutex m_mutex;
+   std::vector<std::string> m_lines;
+
+   void initialize() throw(basis::RuntimeException) {;}
+   void apply(const coffee::logger::Level::_v level, const std::string& line) noexcept {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_lines.push_back(line);
+   }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,142 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <coffee/logger/Formatter.hpp>
+#include <coffee/logger/Logger.hpp>
+#include <coffee/logger/Throttle.hpp>
+#include <coffee/logger/Writer.hpp>
+
+#include "TestWriter.hpp"
+
+using namespace coffee;
+using namespace coffee::logger;
+using coffee::test::logger::MessageFormatter;
+using coffee::test::logger::LinesWriter;
+
+struct ThrottleFixture : public ::testing::Test {
+   ThrottleFixture() : writer(std::make_shared<LinesWriter>()) {
+      Logger::initialize(writer, std::make_shared<MessageFormatter>());
+      Logger::setLevel(Level::Debug);
+   }
+
+   std::shared_ptr<LinesWriter> writer;
+};
+
+TEST_F(ThrottleFixture, every_n)
+{
+   for (int ii = 0; ii < 100; ++ ii) {
+      LOG_WARN_EVERY_N(10, "line " << ii);
+   }
+
+   auto lines = writer->getLines();
+   ASSERT_EQ(10, lines.size());
+   ASSERT_EQ("line 0", lines[0]);
+   ASSERT_EQ("line 10 [9 similar traces suppressed]", lines[1]);
+   ASSERT_EQ("line 90 [9 similar traces suppressed]", lines[9]);
+}
+
+TEST_F(ThrottleFixture, first_n)
+{
+   for (int ii = 0; ii < 100; ++ ii) {
+      LOG_ERROR_FIRST_N(5, "line " << ii);
+   }
+
+   auto lines = writer->getLines();
+   ASSERT_EQ(5, lines.size());
+   ASSERT_EQ("line 4", lines[4]);
+}
+
+TEST_F(ThrottleFixture, rate)
+{
+   auto start = std::chrono::steady_clock::now();
+
+   for (int ii = 0; ii < 10000; ++ ii) {
+      LOG_ERROR_RATE(20, "line " << ii);
+   }
+
+   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+   const size_t maxLines = 20 + (elapsed.count() * 20) / 1000 + 1;
+
+   auto lines = writer->getLines();
+   ASSERT_LE(20, lines.size());
+   ASSERT_GE(maxLines, lines.size());
+}
+
+TEST_F(ThrottleFixture, many_threads)
+{
+   std::vector<std::thread> threads;
+
+   for (int ii = 0; ii < 4; ++ ii) {
+      threads.emplace_back([]() {
+         for (int jj = 0; jj < 1000; ++ jj) {
+            LOG_INFO_EVERY_N(100, "line " << jj);
+         }
+      });
+   }
+
+   for (auto& thread : threads)
+      thread.join();
+
+   ASSERT_EQ(40, writer->getLines().size());
+}
+
+TEST_F(ThrottleFixture, disabled_level)
+{
+   Logger::setLevel(Level::Warning);
+
+   for (int ii = 0; ii < 100; ++ ii) {
+      LOG_DEBUG_FIRST_N(5, "line " << ii);
+   }
+
+   ASSERT_EQ(0, writer->getLines().size());
+}
+
+TEST(ThrottleTest, summary)
+{
+   Throttle throttle(Throttle::Mode::FirstN, 1, std::chrono::milliseconds(20));
+   unsigned suppressed;
+
+   ASSERT_TRUE(throttle.accept(suppressed));
+   ASSERT_EQ(0, suppressed);
+
+   for (int ii = 0; ii < 10; ++ ii) {
+      ASSERT_FALSE(throttle.accept(suppressed));
+      ASSERT_FALSE(throttle.summarize(suppressed));
+   }
+
+   std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+   ASSERT_FALSE(throttle.accept(suppressed));
+   ASSERT_TRUE(throttle.summarize(suppressed));
+   ASSERT_EQ(11, suppressed);
+
+   // Nothing suppressed since the last summary
+   std::this_thread::sleep_for(std::chrono::milliseconds(30));
+   ASSERT_FALSE(throttle.summarize(suppressed));
+}
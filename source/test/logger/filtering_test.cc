@@ -21,6 +21,9 @@
 // SOFTWARE.
 //
 
+#include <atomic>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <coffee/logger/Logger.hpp>
@@ -61,6 +64,52 @@ private:
    }
 };
 
+class SharedCounterWriter : public logger::Writer {
+public:
+   explicit SharedCounterWriter(std::atomic<int>& total) : logger::Writer("SharedCounterWriter"), m_total(total) {;}
+
+private:
+   std::atomic<int>& m_total;
+
+   void initialize() throw(basis::RuntimeException) {;}
+   void apply(const logger::Level::_v level, const std::string& line) throw() { ++ m_total; }
+};
+
+class ReentrantWriter : public logger::Writer {
+public:
+   ReentrantWriter() : logger::Writer("ReentrantWriter"), m_rejected(false) {;}
+
+   bool isRejected() const noexcept { return m_rejected; }
+
+private:
+   bool m_rejected;
+
+   void initialize() throw(basis::RuntimeException) {;}
+   void apply(const logger::Level::_v level, const std::string& line) throw() {
+      try {
+         logger::Logger::add(std::make_shared<ReentrantWriter>());
+      }
+      catch (basis::RuntimeException&) {
+         m_rejected = true;
+      }
+   }
+};
+
+class SwitchableWriter : public logger::Writer {
+public:
+   SwitchableWriter() : logger::Writer("SwitchableWriter"), m_enabled(true), m_total(0) {;}
+
+   void enable(const bool enabled) noexcept { m_enabled = enabled; levelsChanged(); }
+   int getTotal() const noexcept { return m_total; }
+
+private:
+   bool m_enabled;
+   int m_total;
+
+   void initialize() throw(basis::RuntimeException) {;}
+   bool wantsToProcess(const logger::Level::_v level) const noexcept { return m_enabled && logger::Writer::wantsToProcess(level); }
+   void apply(const logger::Level::_v level, const std::string& line) throw() { ++ m_total; }
+};
 
 using namespace coffee::logger;
 
@@ -144,3 +193,76 @@ TEST(FilteringLogTest,use_every_level)
    ASSERT_EQ(Level::Local7 + 1, ss->getTotal());
 }
 
+
+TEST(FilteringLogTest,reconfigure_while_writing)
+{
+   std::atomic<int> total(0);
+   std::atomic<bool> stop(false);
+
+   Logger::initialize(std::make_shared<SharedCounterWriter>(total), std::make_shared<DummyFormatter>());
+   Logger::setLevel(Level::Debug);
+
+   std::vector<std::thread> producers;
+   for (int ii = 0; ii < 4; ++ ii) {
+      producers.emplace_back([&stop]() {
+         while (!stop) {
+            LOG_DEBUG("line");
+         }
+      });
+   }
+
+   while (total == 0) {
+      std::this_thread::yield();
+   }
+
+   for (int ii = 0; ii < 200; ++ ii) {
+      auto writer = std::make_shared<SharedCounterWriter>(total);
+      std::weak_ptr<Writer> previous(writer);
+      Logger::initialize(writer, std::make_shared<DummyFormatter>());
+      Logger::add(std::make_shared<SharedCounterWriter>(total));
+      writer.reset();
+
+      Logger::initialize(std::make_shared<SharedCounterWriter>(total), std::make_shared<DummyFormatter>());
+
+      // Once the registry has been replaced no thread can be using the previous writers
+      ASSERT_TRUE(previous.expired());
+   }
+
+   stop = true;
+   for (auto& producer : producers)
+      producer.join();
+}
+
+TEST(FilteringLogTest,reconfigure_from_writer)
+{
+   auto writer = std::make_shared<ReentrantWriter>();
+   Logger::initialize(writer, std::make_shared<DummyFormatter>());
+
+   LOG_ERROR("line");
+
+   ASSERT_TRUE(writer->isRejected());
+}
+
+TEST(FilteringLogTest,cached_level_mask)
+{
+   auto writer = std::make_shared<SwitchableWriter>();
+   Logger::initialize(writer, std::make_shared<DummyFormatter>());
+
+   Logger::setLevel(Level::Warning);
+   ASSERT_TRUE(Logger::wantsToProcess(Level::Warning));
+   ASSERT_FALSE(Logger::wantsToProcess(Level::Debug));
+   ASSERT_FALSE(Logger::wantsToProcess(Level::None));
+
+   Logger::setLevel(Level::Debug);
+   ASSERT_TRUE(Logger::wantsToProcess(Level::Debug));
+   ASSERT_FALSE(Logger::wantsToProcess(Level::Local0));
+
+   writer->enable(false);
+   ASSERT_FALSE(Logger::wantsToProcess(Level::Error));
+   LOG_ERROR("line");
+   ASSERT_EQ(0, writer->getTotal());
+
+   writer->enable(true);
+   LOG_ERROR("line");
+   ASSERT_EQ(1, writer->getTotal());
+}
@@ -25,6 +25,7 @@
 
 #include <coffee/networking/NetworkingService.hpp>
 #include <coffee/networking/ClientSocket.hpp>
+#include <coffee/time/Deadline.hpp>
 
 #include "NetworkingFixture.hpp"
 
@@ -99,3 +100,32 @@ TEST_F(NetworkingFixture, clientsocket_unkwown_server)
    basis::DataBlock request("Send to an non existant server");
    ASSERT_THROW(clientSocket->send(request), basis::RuntimeException);
 }
+
+TEST_F(NetworkingFixture, clientsocket_deadline)
+{
+   networking::SocketArguments arguments;
+   auto clientSocket = networkingService->createClientSocket(arguments.addEndPoint("tcp://localhost:5555"));
+
+   auto deadline = time::Deadline::instantiate(*timeService, std::chrono::milliseconds(500));
+
+   basis::DataBlock request("work");
+   auto response = clientSocket->send(request, deadline);
+   ASSERT_EQ("WORK", std::string(response.data()));
+
+   deadline->cancel();
+   ASSERT_TRUE(timeService->empty());
+}
+
+TEST_F(NetworkingFixture, clientsocket_deadline_expired)
+{
+   networking::SocketArguments arguments;
+   auto clientSocket = networkingService->createClientSocket(arguments.addEndPoint("tcp://localhost:7777"));
+
+   auto deadline = time::Deadline::instantiate(*timeService, std::chrono::milliseconds(200));
+
+   const auto start = std::chrono::steady_clock::now();
+   basis::DataBlock request("Send to an non existant server");
+   ASSERT_THROW(clientSocket->send(request, deadline), basis::RuntimeException);
+   ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+   ASSERT_TRUE(deadline->isExpired());
+}
@@ -45,12 +45,14 @@ void NetworkingFixture::SetUp()
    logger::Logger::setLevel(logger::Level::Debug);
 
    networkingService = networking::NetworkingService::instantiate(app);
+   timeService = time::TimeService::instantiate(app, std::chrono::milliseconds(1000), std::chrono::milliseconds(10));
    networking::SocketArguments arguments;
    arguments.setMessageHandler(UpperStringHandler::instantiate()).addEndPoint("tcp://*:5555").addEndPoint("tcp://*:5556");
    upperServer = networkingService->createServerSocket(arguments);
    thr = std::thread(parallelRun, std::ref(app));
    app.waitUntilRunning();
    networkingService->waitEffectiveRunning();
+   timeService->waitEffectiveRunning();
 }
 
 void NetworkingFixture::TearDown()
@@ -30,6 +30,7 @@
 #include <coffee/networking/AsyncSocket.hpp>
 #include <coffee/networking/ServerSocket.hpp>
 #include <coffee/networking/MessageHandler.hpp>
+#include <coffee/time/TimeService.hpp>
 #include <gtest/gtest.h>
 
 struct NetworkingFixture : ::testing::Test {
@@ -74,6 +75,7 @@ struct NetworkingFixture : ::testing::Test {
 
    coffee::app::ApplicationServiceStarter app;
    std::shared_ptr<coffee::networking::NetworkingService> networkingService;
+   std::shared_ptr<coffee::time::TimeService> timeService;
    std::thread thr;
    std::shared_ptr<coffee::networking::ServerSocket> upperServer;
 
@@ -23,6 +23,7 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <chrono>
 
@@ -134,3 +135,41 @@ TEST_F(ClockTestFixture, terminate_noempty)
    ASSERT_NO_THROW(timeService->activate(clock));
    finalizeEmpty = false;
 }
+
+class SlowClockObserver : public basis::pattern::observer::Observer {
+public:
+   SlowClockObserver() : basis::pattern::observer::Observer("SlowClockObserver"), counter(0) {;}
+
+   std::atomic<int> counter;
+
+private:
+   void attached(const Subject& subject) noexcept { }
+   void update(const Subject& subject, const Event& event) noexcept {
+      // The first one delays the processing of the following ticks
+      if (counter ++ == 0)
+         usleep(150000);
+   }
+   void detached(const Subject& subject) noexcept {  }
+};
+
+TEST_F(ClockTestFixture, no_drift)
+{
+   auto observer = std::make_shared<SlowClockObserver>();
+   timeService->attach(observer);
+
+   const int ticks = 20;
+   const milliseconds period(50);
+
+   auto startTime = std::chrono::steady_clock::now();
+   auto clock = time::Clock::instantiate(111, period);
+   ASSERT_NO_THROW(timeService->activate(clock));
+
+   while (observer->counter < ticks)
+      usleep(1000);
+
+   auto elapsed = std::chrono::duration_cast<milliseconds>(std::chrono::steady_clock::now() - startTime);
+   ASSERT_TRUE(timeService->cancel(clock));
+
+   ASSERT_GE(elapsed, period * ticks);
+   ASSERT_LE(elapsed, period * ticks + ShortResolution * 2);
+}
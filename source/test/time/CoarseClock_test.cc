@@ -0,0 +1,99 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <coffee/logger/Logger.hpp>
+
+#include <coffee/time/CoarseClock.hpp>
+
+#include "TimeFixture.hpp"
+
+using namespace coffee;
+using std::chrono::milliseconds;
+
+namespace {
+
+milliseconds distance(const time::CoarseClock::time_point& coarse) {
+   const auto precise = std::chrono::duration_cast<milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+   const auto difference = precise - coarse.time_since_epoch();
+   return (difference < milliseconds::zero()) ? -difference : difference;
+}
+
+}
+
+struct CoarseClockTestFixture : public TimeFixture {
+   static const milliseconds Resolution;
+
+   CoarseClockTestFixture() : TimeFixture(milliseconds(1000), Resolution, 1, 1) {;}
+};
+
+const milliseconds CoarseClockTestFixture::Resolution(5);
+
+TEST(CoarseClockTest, kernel)
+{
+   ASSERT_FALSE(time::CoarseClock::isDriven());
+
+   // CLOCK_REALTIME_COARSE is updated on every jiffy
+   ASSERT_LE(distance(time::CoarseClock::now()), milliseconds(20));
+}
+
+TEST(CoarseClockTest, not_driven_by_coarse_service)
+{
+   app::ApplicationServiceStarter app("TestCoarseClock");
+   auto timeService = time::TimeService::instantiate(app, milliseconds(1000), milliseconds(100));
+   ASSERT_FALSE(time::CoarseClock::isDriven());
+}
+
+TEST(CoarseClockTest, not_driven_without_workers)
+{
+   app::ApplicationServiceStarter app("TestCoarseClock");
+   auto timeService = time::TimeService::instantiate(app, milliseconds(1000), CoarseClockTestFixture::Resolution);
+   ASSERT_FALSE(time::CoarseClock::isDriven());
+}
+
+TEST_F(CoarseClockTestFixture, driven_by_service)
+{
+   ASSERT_TRUE(time::CoarseClock::isDriven());
+
+   for (int ii = 0; ii < 10; ++ ii) {
+      ASSERT_LE(distance(time::CoarseClock::now()), Resolution * 4);
+      std::this_thread::sleep_for(Resolution * 3);
+   }
+}
+
+TEST(CoarseClockTest, attach_detach)
+{
+   time::CoarseClock::attach();
+   ASSERT_TRUE(time::CoarseClock::isDriven());
+
+   const auto published = time::CoarseClock::now();
+   std::this_thread::sleep_for(milliseconds(20));
+
+   // Nobody updates it, so it keeps the published value
+   ASSERT_EQ(published, time::CoarseClock::now());
+
+   time::CoarseClock::detach();
+   ASSERT_FALSE(time::CoarseClock::isDriven());
+   ASSERT_LE(distance(time::CoarseClock::now()), milliseconds(20));
+}
@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <poll.h>
+
+#include <gtest/gtest.h>
+
+#include <coffee/logger/Logger.hpp>
+
+#include <coffee/basis/pattern/observer/Observer.hpp>
+
+#include <coffee/time/Deadline.hpp>
+
+#include "TimeFixture.hpp"
+
+using namespace coffee;
+using std::chrono::milliseconds;
+
+namespace {
+
+class CounterObserver : public basis::pattern::observer::Observer {
+public:
+   CounterObserver() : basis::pattern::observer::Observer("CounterObserver"), counter(0) {;}
+
+   std::atomic<int> counter;
+
+private:
+   void attached(const basis::pattern::observer::Subject& subject) noexcept {;}
+   void update(const basis::pattern::observer::Subject& subject, const basis::pattern::observer::Event& event) noexcept { ++ counter; }
+};
+
+bool isReadable(const int fd, const milliseconds& timeout) {
+   pollfd item = { fd, POLLIN, 0 };
+   return poll(&item, 1, timeout.count()) == 1 && (item.revents & POLLIN);
+}
+
+}
+
+struct DeadlineTestFixture : public TimeFixture {
+   DeadlineTestFixture() : TimeFixture(milliseconds(1000), milliseconds(10)) {;}
+};
+
+TEST_F(DeadlineTestFixture, expire)
+{
+   auto observer = std::make_shared<CounterObserver>();
+   timeService->attach(observer);
+
+   auto deadline = time::Deadline::instantiate(*timeService, milliseconds(50));
+
+   ASSERT_TRUE(deadline->isActivated());
+   ASSERT_FALSE(deadline->isExpired());
+   ASSERT_LT(milliseconds::zero(), deadline->getRemaining());
+   ASSERT_GE(milliseconds(50), deadline->getRemaining());
+   ASSERT_FALSE(isReadable(deadline->getFileDescriptor(), milliseconds::zero()));
+
+   ASSERT_TRUE(isReadable(deadline->getFileDescriptor(), milliseconds(1000)));
+   ASSERT_TRUE(deadline->isExpired());
+   ASSERT_EQ(milliseconds::zero(), deadline->getRemaining());
+
+   // The observers of the service are not bothered with the deadlines
+   ASSERT_EQ(0, observer->counter.load());
+}
+
+TEST_F(DeadlineTestFixture, cancel)
+{
+   auto deadline = time::Deadline::instantiate(*timeService, milliseconds(50));
+
+   deadline->cancel();
+   ASSERT_FALSE(deadline->isActivated());
+   ASSERT_TRUE(timeService->empty());
+
+   ASSERT_FALSE(isReadable(deadline->getFileDescriptor(), milliseconds(100)));
+   ASSERT_TRUE(deadline->isExpired());
+}
+
+TEST_F(DeadlineTestFixture, different_ids)
+{
+   auto first = time::Deadline::instantiate(*timeService, milliseconds(50));
+   auto second = time::Deadline::instantiate(*timeService, milliseconds(50));
+
+   ASSERT_NE(first->getId(), second->getId());
+
+   first->cancel();
+   second->cancel();
+}
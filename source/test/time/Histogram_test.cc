@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2018 Francisco Ruiz (francisco.ruiz.rayo@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <coffee/xml/Node.hpp>
+#include <coffee/xml/Attribute.hpp>
+
+#include <coffee/time/Histogram.hpp>
+
+using namespace coffee;
+using std::chrono::microseconds;
+
+TEST(HistogramTest, empty)
+{
+   time::Histogram histogram("Empty");
+
+   ASSERT_EQ("Empty", histogram.getName());
+   ASSERT_EQ(0, histogram.getCounter());
+   ASSERT_EQ(microseconds::zero(), histogram.getAverage());
+   ASSERT_EQ(microseconds::zero(), histogram.getPercentile(99));
+   ASSERT_EQ(microseconds::zero(), histogram.getMax());
+}
+
+TEST(HistogramTest, buckets)
+{
+   time::Histogram histogram("Buckets");
+
+   histogram.add(microseconds(0));
+   histogram.add(microseconds(-10));
+   histogram.add(microseconds(1));
+   histogram.add(microseconds(3));
+   histogram.add(microseconds(1000));
+
+   ASSERT_EQ(2, histogram.getBucketCounter(0));
+   ASSERT_EQ(1, histogram.getBucketCounter(1));
+   ASSERT_EQ(1, histogram.getBucketCounter(2));
+   ASSERT_EQ(1, histogram.getBucketCounter(10));
+   ASSERT_EQ(microseconds(1024), time::Histogram::getUpperBound(10));
+
+   ASSERT_EQ(5, histogram.getCounter());
+   ASSERT_EQ(microseconds(1004), histogram.getSum());
+   ASSERT_EQ(microseconds(1000), histogram.getMax());
+   ASSERT_EQ(microseconds(200), histogram.getAverage());
+}
+
+TEST(HistogramTest, percentiles)
+{
+   time::Histogram histogram("Percentiles");
+
+   for (int ii = 0; ii < 99; ++ ii)
+      histogram.add(microseconds(100));
+
+   histogram.add(microseconds(5000));
+
+   ASSERT_EQ(microseconds(128), histogram.getPercentile(50));
+   ASSERT_EQ(microseconds(128), histogram.getPercentile(99));
+   ASSERT_EQ(microseconds(5000), histogram.getPercentile(100));
+}
+
+TEST(HistogramTest, as_xml)
+{
+   time::Histogram histogram("Xml");
+
+   histogram.add(microseconds(100));
+   histogram.add(microseconds(5000));
+
+   auto root = std::make_shared<xml::Node>("root");
+   auto node = histogram.asXML(root);
+
+   ASSERT_EQ("Xml", node->lookupAttribute("Name")->getValue());
+   ASSERT_EQ("2", node->lookupAttribute("Counter")->getValue());
+   ASSERT_EQ(2, node->children_size());
+}
@@ -36,7 +36,7 @@ struct TimeFixture : public ::testing::Test {
    std::shared_ptr<coffee::time::TimeService> timeService;
    std::thread thr;
 
-   TimeFixture(const std::chrono::milliseconds& maxTime, const std::chrono::milliseconds& resolution) :
+   TimeFixture(const std::chrono::milliseconds& maxTime, const std::chrono::milliseconds& resolution, const int shards = 1, const int workers = 0) :
       app("TestAppTimeFixture"),
       finalizeEmpty(true)
    {
@@ -45,7 +45,7 @@ struct TimeFixture : public ::testing::Test {
       coffee::logger::Logger::initialize(std::make_shared<coffee::logger::UnlimitedTraceWriter>(logFileName));
       coffee::logger::Logger::setLevel(coffee::logger::Level::Debug);
 
-      timeService = coffee::time::TimeService::instantiate(app, maxTime, resolution);
+      timeService = coffee::time::TimeService::instantiate(app, maxTime, resolution, shards, workers);
       thr = std::thread(parallelRun, std::ref(app));
       app.waitUntilRunning();
       timeService->waitEffectiveRunning();
@@ -32,10 +32,14 @@
 #include <coffee/logger/Logger.hpp>
 #include <coffee/logger/TtyWriter.hpp>
 
+#include <coffee/time/Clock.hpp>
 #include <coffee/time/Timer.hpp>
 #include <coffee/time/TimeService.hpp>
 #include <coffee/time/TimeEvent.hpp>
 
+#include <coffee/xml/Node.hpp>
+#include <coffee/xml/Attribute.hpp>
+
 #include "TimeFixture.hpp"
 
 using namespace coffee;
@@ -151,17 +155,28 @@ TEST_F(TimerTestFixture, zero_timeout)
 
 TEST_F(TimerTestFixture, over_maxtimeout)
 {
+   auto observer = std::make_shared<TimerObserver>();
+   timeService->attach(observer);
+
    auto timer = time::Timer::instantiate(100, milliseconds(1500));
-   ASSERT_THROW(timeService->activate(timer), basis::RuntimeException);
+   ASSERT_NO_THROW(timeService->activate(timer));
+
+   ASSERT_TRUE(observer->receiveTimedouts(timeService, milliseconds(1500)));
+   ASSERT_GE(timer->getDuration().count(), 1500);
 }
 
 TEST_F(TimerTestFixture, below_resolution)
 {
+   auto observer = std::make_shared<TimerObserver>();
+   timeService->attach(observer);
+
    auto timer = time::Timer::instantiate(100, milliseconds(10));
-   ASSERT_THROW(timeService->activate(timer), basis::RuntimeException);
+   ASSERT_NO_THROW(timeService->activate(timer));
+
+   ASSERT_TRUE(observer->receiveTimedouts(timeService, ShortResolution * 2));
 }
 
-TEST_F(TimerTestFixture, repeat_id)
+TEST_F(TimerTestFixture, repeat_activation)
 {
    auto observer = std::make_shared<TimerObserver>();
    timeService->attach(observer);
@@ -169,12 +184,40 @@ TEST_F(TimerTestFixture, repeat_id)
    auto firstTimer = time::Timer::instantiate(3333, time100ms);
    EXPECT_NO_THROW(timeService->activate(firstTimer));
 
-   auto secondTimer = time::Timer::instantiate(3333, time200ms);
-   ASSERT_THROW(timeService->activate(secondTimer), basis::RuntimeException);
+   ASSERT_THROW(timeService->activate(firstTimer), basis::RuntimeException);
 
    ASSERT_TRUE(observer->receiveTimedouts(timeService, time200ms));
 }
 
+TEST_F(TimerTestFixture, activate_and_cancel)
+{
+   std::vector<std::shared_ptr<time::Timer> > timers;
+
+   for (int ii = 0; ii < 1000; ++ ii) {
+      timers.push_back(time::Timer::instantiate(ii, milliseconds(100 + ii)));
+      ASSERT_NO_THROW(timeService->activate(timers.back()));
+      ASSERT_TRUE(timers.back()->isActivated());
+   }
+   ASSERT_EQ(1000, timeService->size());
+
+   // From the middle, the ends and then again the same ones
+   for (int ii = 0; ii < 1000; ii += 2)
+      ASSERT_TRUE(timeService->cancel(timers[ii]));
+
+   ASSERT_EQ(500, timeService->size());
+
+   for (int ii = 0; ii < 1000; ii += 2) {
+      ASSERT_FALSE(timers[ii]->isActivated());
+      ASSERT_FALSE(timeService->cancel(timers[ii]));
+      ASSERT_NO_THROW(timeService->activate(timers[ii]));
+   }
+
+   for (auto timer : timers)
+      ASSERT_TRUE(timeService->cancel(timer));
+
+   ASSERT_TRUE(timeService->empty());
+}
+
 TEST_F(TimerTestFixture, timeout)
 {
    auto observer = std::make_shared<TimerObserver>();
@@ -229,3 +272,259 @@ TEST_F(LongTimerTestFixture, populate)
    ASSERT_LE(avgDeviation.value().count(), LongResolution.count());
 }
 
+
+struct FineTimerTestFixture : public TimeFixture {
+   FineTimerTestFixture() : TimeFixture(std::chrono::hours(8), milliseconds(5)) {;}
+};
+
+TEST_F(FineTimerTestFixture, levels)
+{
+   ASSERT_EQ(4, timeService->getLevels());
+   ASSERT_NE(std::string::npos, timeService->asString().find("Levels=4"));
+}
+
+TEST_F(FineTimerTestFixture, cascade)
+{
+   auto observer = std::make_shared<TimerObserver>();
+   timeService->attach(observer);
+
+   // They are stored on the first and the second level of the wheel
+   std::vector<std::shared_ptr<time::Timer> > timers;
+   for (int timeout : { 5, 100, 1300, 1500 }) {
+      timers.push_back(time::Timer::instantiate(timeout, milliseconds(timeout)));
+      ASSERT_NO_THROW(timeService->activate(timers.back()));
+   }
+
+   auto longTimer = time::Timer::instantiate(1, std::chrono::hours(2));
+   ASSERT_NO_THROW(timeService->activate(longTimer));
+   ASSERT_EQ(5, timeService->size());
+
+   for (int ii = 0; ii < 100 && timeService->size() > 1; ++ ii)
+      usleep(50000);
+
+   ASSERT_EQ(1, timeService->size());
+
+   for (auto timer : timers) {
+      ASSERT_TRUE(timer->isFinished());
+      ASSERT_GE(timer->getDuration(), timer->getTimeout());
+   }
+
+   ASSERT_TRUE(timeService->cancel(longTimer));
+}
+
+struct ShardedTimerTestFixture : public TimeFixture {
+   ShardedTimerTestFixture() : TimeFixture(milliseconds(1000), milliseconds(10), 4) {;}
+};
+
+// Activates again every timer while it is being notified
+class RestartObserver : public basis::pattern::observer::Observer {
+public:
+   RestartObserver(std::shared_ptr<time::TimeService>& _timeService, std::shared_ptr<time::Timer> _timer, const int _maxCounter) :
+      basis::pattern::observer::Observer("RestartObserver"),
+      timeService(_timeService),
+      timer(_timer),
+      maxCounter(_maxCounter),
+      counter(0)
+   {;}
+
+   std::atomic<int> counter;
+
+private:
+   std::shared_ptr<time::TimeService>& timeService;
+   std::shared_ptr<time::Timer> timer;
+   const int maxCounter;
+
+   void attached(const Subject& subject) noexcept { }
+   void update(const Subject& subject, const Event& event) noexcept {
+      if (++ counter <= maxCounter)
+         timeService->activate(timer);
+   }
+   void detached(const Subject& subject) noexcept {  }
+};
+
+TEST(TimerTest, bad_shards)
+{
+   app::ApplicationServiceStarter app("test_timer_bad_shards");
+   ASSERT_THROW(time::TimeService::instantiate(app, milliseconds(1000), milliseconds(100), 0), basis::RuntimeException);
+}
+
+TEST_F(ShardedTimerTestFixture, parallel_activation)
+{
+   ASSERT_EQ(4, timeService->getShards());
+   ASSERT_NE(std::string::npos, timeService->asString().find("Shards=4"));
+
+   auto observer = std::make_shared<TimerObserver>();
+   timeService->attach(observer);
+
+   std::vector<std::thread> threads;
+   std::vector<std::shared_ptr<time::Timer> > timers;
+
+   for (int ii = 0; ii < 400; ++ ii)
+      timers.push_back(time::Timer::instantiate(ii, milliseconds(20 + ii % 50)));
+
+   for (int tt = 0; tt < 4; ++ tt) {
+      threads.emplace_back([this, tt, &timers]() {
+         for (int ii = tt * 100; ii < (tt + 1) * 100; ++ ii)
+            timeService->activate(timers[ii]);
+
+         // Half of them are cancelled, may be from other thread than the one which activated them
+         for (int ii = tt * 100; ii < (tt + 1) * 100; ii += 2) {
+            timeService->cancel(timers[399 - ii]);
+         }
+      });
+   }
+
+   for (auto& thread : threads)
+      thread.join();
+
+   ASSERT_TRUE(observer->receiveTimedouts(timeService, milliseconds(200)));
+}
+
+TEST_F(ShardedTimerTestFixture, parallel_repeat_activation)
+{
+   auto clock = time::Clock::instantiate(1, milliseconds(10));
+   std::atomic<int> activations(0);
+   std::vector<std::thread> threads;
+
+   // Every thread works on its own shard while the clock expires on the first one
+   for (int tt = 0; tt < 4; ++ tt) {
+      threads.emplace_back([this, &clock, &activations]() {
+         const auto limit = std::chrono::steady_clock::now() + milliseconds(200);
+
+         while (std::chrono::steady_clock::now() < limit) {
+            try {
+               timeService->activate(clock);
+               ++ activations;
+            }
+            catch (basis::RuntimeException&) {
+            }
+         }
+      });
+   }
+
+   for (auto& thread : threads)
+      thread.join();
+
+   ASSERT_EQ(1, activations.load());
+   ASSERT_EQ(1, timeService->size());
+   ASSERT_TRUE(timeService->cancel(clock));
+}
+
+TEST_F(ShardedTimerTestFixture, activate_from_observer)
+{
+   auto timer = time::Timer::instantiate(1, milliseconds(20));
+   auto observer = std::make_shared<RestartObserver>(timeService, timer, 5);
+   timeService->attach(observer);
+
+   ASSERT_NO_THROW(timeService->activate(timer));
+
+   for (int ii = 0; ii < 100 && observer->counter <= 5; ++ ii)
+      usleep(10000);
+
+   ASSERT_EQ(6, observer->counter);
+   ASSERT_TRUE(timeService->empty());
+}
+
+struct WorkerTimerTestFixture : public TimeFixture {
+   static const int Workers = 4;
+   WorkerTimerTestFixture() : TimeFixture(milliseconds(1000), milliseconds(10), 1, Workers) {;}
+};
+
+const int WorkerTimerTestFixture::Workers;
+
+// Keeps the order of the received events
+class OrderObserver : public basis::pattern::observer::Observer {
+public:
+   OrderObserver(const std::string& name, const milliseconds& _delay) :
+      basis::pattern::observer::Observer(name),
+      delay(_delay)
+   {;}
+
+   std::mutex mutex;
+   std::vector<std::pair<Event::Id, std::chrono::steady_clock::time_point> > events;
+
+private:
+   const milliseconds delay;
+
+   void attached(const Subject& subject) noexcept { }
+   void update(const Subject& subject, const Event& event) noexcept {
+      usleep(delay.count() * 1000);
+      std::unique_lock <std::mutex> guard(mutex);
+      events.emplace_back(event.getId(), std::chrono::steady_clock::now());
+   }
+   void detached(const Subject& subject) noexcept {  }
+};
+
+TEST_F(WorkerTimerTestFixture, slow_observer)
+{
+   ASSERT_EQ(Workers, timeService->getWorkers());
+
+   // Both observers must be notified by different workers
+   std::hash<std::string> hash;
+   std::string fastName("fast");
+   while ((hash(fastName) % Workers) == (hash("slow") % Workers))
+      fastName += "+";
+
+   auto slow = std::make_shared<OrderObserver>("slow", milliseconds(200));
+   auto fast = std::make_shared<OrderObserver>(fastName, milliseconds(0));
+   timeService->attach(slow);
+   timeService->attach(fast);
+
+   const auto startTime = std::chrono::steady_clock::now();
+
+   std::vector<std::shared_ptr<time::Timer> > timers;
+   for (int ii = 1; ii <= 3; ++ ii) {
+      timers.push_back(time::Timer::instantiate(ii, milliseconds(20 * ii)));
+      ASSERT_NO_THROW(timeService->activate(timers.back()));
+   }
+
+   for (int ii = 0; ii < 200 && timeService->getCallbackCounter() < 6; ++ ii)
+      usleep(10000);
+
+   ASSERT_EQ(6, timeService->getCallbackCounter());
+   ASSERT_GE(timeService->getMaxCallbackDuration(), milliseconds(200));
+
+   for (auto observer : { slow, fast }) {
+      ASSERT_EQ(3, observer->events.size());
+      for (int ii = 0; ii < 3; ++ ii)
+         ASSERT_EQ(ii + 1, observer->events[ii].first);
+   }
+
+   // The fast one did not have to wait for the slow one
+   ASSERT_LT(fast->events.back().second - startTime, milliseconds(200));
+   ASSERT_GE(slow->events.back().second - startTime, milliseconds(600));
+}
+
+TEST_F(TimerTestFixture, metrics)
+{
+   auto observer = std::make_shared<TimerObserver>();
+   timeService->attach(observer);
+
+   for (int ii = 1; ii <= 4; ++ ii) {
+      ASSERT_NO_THROW(timeService->activate(time::Timer::instantiate(ii, ShortResolution * ii)));
+   }
+
+   ASSERT_TRUE(observer->receiveTimedouts(timeService, ShortResolution * 4));
+
+   // Expirations are never early and they are not delayed more than one quantum on a quiet service
+   const time::Histogram& lateness = timeService->getLateness();
+   ASSERT_EQ(4, lateness.getCounter());
+   ASSERT_LE(lateness.getMax(), ShortResolution * 2);
+
+   ASSERT_GE(timeService->getQuantumProcessing().getCounter(), 4);
+   ASSERT_EQ(4, timeService->getCallbacks().getCounter());
+
+   auto root = std::make_shared<xml::Node>("root");
+   auto node = timeService->asXML(root);
+
+   auto shard = node->lookupChild("Shards")->lookupChild("Shard");
+   ASSERT_EQ("4", shard->lookupAttribute("MaxTimeEvents")->getValue());
+   ASSERT_EQ("0", shard->lookupAttribute("TimeEvents")->getValue());
+
+   int histograms = 0;
+   for (auto ii = node->child_begin(), maxii = node->child_end(); ii != maxii; ++ ii) {
+      if ((*ii)->getName() == "time.Histogram")
+         ++ histograms;
+   }
+   ASSERT_EQ(3, histograms);
+}